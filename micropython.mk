@@ -12,10 +12,12 @@ SRC_USERMOD += \
     $(UUR_MOD_DIR)/uUR.c \
     $(UUR_MOD_DIR)/src/ur.c \
     $(UUR_MOD_DIR)/src/ur_encoder.c \
+    $(UUR_MOD_DIR)/src/ur_file.c \
     $(UUR_MOD_DIR)/src/ur_decoder.c \
     $(UUR_MOD_DIR)/src/fountain_encoder.c \
     $(UUR_MOD_DIR)/src/fountain_decoder.c \
     $(UUR_MOD_DIR)/src/fountain_utils.c \
+    $(UUR_MOD_DIR)/src/fountain_fixed.c \
     $(UUR_MOD_DIR)/src/bytewords.c \
     $(UUR_MOD_DIR)/src/crc32.c \
     $(UUR_MOD_DIR)/src/utils.c \
@@ -30,6 +32,7 @@ SRC_USERMOD += \
     $(UUR_MOD_DIR)/src/types/multi_key.c \
     $(UUR_MOD_DIR)/src/types/output.c \
     $(UUR_MOD_DIR)/src/types/psbt.c \
+    $(UUR_MOD_DIR)/src/types/payload_check.c \
     $(UUR_MOD_DIR)/src/types/registry.c
 
 CFLAGS_USERMOD += -I$(UUR_MOD_DIR) -I$(UUR_MOD_DIR)/src -DUR_USE_K210_SHA256
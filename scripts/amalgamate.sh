@@ -0,0 +1,163 @@
+#!/bin/bash
+#
+# Generate the single-translation-unit build (`make amalgamation`):
+#
+#   ur_amalgamated.c  every source in UR_ENVELOPE_SRCS (CMakeLists.txt), the
+#                     bundled SHA-256, with --with-types UR_TYPES_SRCS and
+#                     with --with-pipeline UR_PIPELINE_SRCS (needs pthreads),
+#                     with all project headers inlined
+#   ur.h              the public (UR_API) headers for code linking against it
+#
+# ur_amalgamated.c defines UR_AMALGAMATION, which turns the UR_INTERNAL
+# helpers (utils.h, xor_internal.h, sha256/sha256.h) static, so compilers
+# without LTO can inline across the bytewords/CRC/fountain boundary and only
+# UR_API symbols are external. Macros a .c file defines are #undef'd after
+# it so they cannot leak into the next file.
+#
+# Usage: scripts/amalgamate.sh [--with-types] [--with-pipeline] [output-dir]
+# The output directory defaults to build/amalgamation/.
+#
+
+set -e
+
+PROJECT_ROOT="$(cd "$(dirname "$0")/.." && pwd)"
+cd "$PROJECT_ROOT"
+
+WITH_TYPES=0
+WITH_PIPELINE=0
+while [ $# -gt 0 ]; do
+    case "$1" in
+    --with-types) WITH_TYPES=1 ;;
+    --with-pipeline) WITH_PIPELINE=1 ;;
+    *) break ;;
+    esac
+    shift
+done
+OUT_DIR="${1:-build/amalgamation}"
+
+# Print the quoted entries of a set(<name> ...) block in CMakeLists.txt.
+cmake_list() {
+    sed -n "/^set($1\$/,/^)/p" CMakeLists.txt | sed -n 's/^ *"\(.*\)"$/\1/p'
+}
+
+SOURCES=$(cmake_list UR_ENVELOPE_SRCS)
+if [ -z "$SOURCES" ]; then
+    echo "amalgamate.sh: UR_ENVELOPE_SRCS not found in CMakeLists.txt" >&2
+    exit 1
+fi
+HEADERS="src/ur.h src/ur_decoder.h src/ur_encoder.h src/fountain_decoder.h \
+src/fountain_encoder.h src/fountain_utils.h src/fountain_fixed.h \
+src/ur_file.h src/bytewords.h src/crc32.h"
+if [ "$WITH_TYPES" = 1 ]; then
+    SOURCES="$SOURCES $(cmake_list UR_TYPES_SRCS)"
+    HEADERS="$HEADERS $(cmake_list UR_TYPES_SRCS | sed 's/\.c$/.h/')"
+fi
+if [ "$WITH_PIPELINE" = 1 ]; then
+    SOURCES="$SOURCES $(cmake_list UR_PIPELINE_SRCS)"
+    HEADERS="$HEADERS $(cmake_list UR_PIPELINE_SRCS | sed 's/\.c$/.h/')"
+fi
+
+declare -A INLINED
+
+# Copy $1 to stdout, replacing each #include "..." that resolves to a project
+# header (relative to the including file, then to src/) with its contents.
+# A header is inlined once at its first unconditional inclusion; inside an
+# #if it is inlined again each time and its include guard sorts it out.
+# Unresolved includes (system or SDK headers) are kept verbatim.
+inline_file() {
+    local file="$1" cond="$2" dir depth=0 guard=0 line name path
+    dir="$(dirname "$file")"
+    case "$file" in *.h) guard=1 ;; esac
+
+    echo "/*** begin ${file#src/} ***/"
+    while IFS= read -r line || [ -n "$line" ]; do
+        if [[ "$line" =~ ^[[:space:]]*#[[:space:]]*if ]]; then
+            depth=$((depth + 1))
+        elif [[ "$line" =~ ^[[:space:]]*#[[:space:]]*endif ]]; then
+            depth=$((depth - 1))
+        elif [[ "$line" =~ ^[[:space:]]*#[[:space:]]*include[[:space:]]*\"([^\"]+)\" ]]; then
+            name="${BASH_REMATCH[1]}"
+            path=""
+            if [ -f "$dir/$name" ]; then
+                path="$(realpath --relative-to=. "$dir/$name")"
+            elif [ -f "src/$name" ]; then
+                path="$(realpath --relative-to=. "src/$name")"
+            fi
+            if [ -n "$path" ]; then
+                if [ -z "${INLINED[$path]}" ]; then
+                    if [ "$cond" = 0 ] && [ "$depth" -le "$guard" ]; then
+                        INLINED[$path]=1
+                        inline_file "$path" 0
+                    else
+                        inline_file "$path" 1
+                    fi
+                fi
+                continue
+            fi
+        fi
+        printf '%s\n' "$line"
+    done <"$file"
+    echo "/*** end ${file#src/} ***/"
+}
+
+# #undef every macro a source file defines, except #ifndef-guarded defaults
+# that a build may override on the command line.
+undef_file_macros() {
+    awk '/^[ \t]*#[ \t]*ifndef[ \t]/ { guarded[$2] = 1 }
+         /^[ \t]*#[ \t]*define[ \t]/ {
+             name = $2; sub(/\(.*/, "", name)
+             if (!(name in guarded) && !(name in seen)) {
+                 seen[name] = 1; print "#undef " name
+             }
+         }' "$1"
+}
+
+banner() {
+    echo "/*"
+    echo " * $1 -- generated by scripts/amalgamate.sh; do not edit."
+    echo " * Sources: $(git describe --always --dirty 2>/dev/null || echo unknown)"
+    echo " */"
+    echo
+}
+
+mkdir -p "$OUT_DIR"
+
+{
+    banner "ur_amalgamated.c"
+    # ur_file.c's feature macro only works ahead of every system header
+    echo "#if (defined(__unix__) || defined(__APPLE__)) && !defined(_POSIX_C_SOURCE)"
+    echo "#define _POSIX_C_SOURCE 200112L"
+    echo "#endif"
+    echo "#define UR_AMALGAMATION 1"
+    echo
+    for src in $SOURCES; do
+        inline_file "$src" 0
+        undef_file_macros "$src"
+        echo
+    done
+    # The embedded backends (mbedTLS PSA, K210) replace the bundled SHA-256,
+    # as in the ESP-IDF component build.
+    echo "#if !defined(UR_USE_MBEDTLS_SHA256) && !defined(UR_USE_K210_SHA256)"
+    inline_file src/sha256/sha256.c 1
+    undef_file_macros src/sha256/sha256.c
+    echo "#endif"
+} >"$OUT_DIR/ur_amalgamated.c"
+
+unset INLINED
+declare -A INLINED
+{
+    banner "ur.h"
+    echo "#ifndef UR_AMALGAMATED_H"
+    echo "#define UR_AMALGAMATED_H"
+    echo
+    for header in $HEADERS; do
+        if [ -z "${INLINED[$header]}" ]; then
+            INLINED[$header]=1
+            inline_file "$header" 0
+        fi
+    done
+    echo
+    echo "#endif // UR_AMALGAMATED_H"
+} >"$OUT_DIR/ur.h"
+
+echo "Amalgamation written to $OUT_DIR/"
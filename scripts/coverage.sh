@@ -51,11 +51,13 @@ INCLUDES="-Isrc"
 # Compile all source files with coverage
 SOURCES=(
     utils.c bytewords.c fountain_decoder.c fountain_encoder.c
-    fountain_utils.c crc32.c ur_decoder.c ur_encoder.c ur.c
+    fountain_utils.c fountain_fixed.c crc32.c ur_decoder.c ur_encoder.c ur_file.c
+    ur.c
+    ur_pipeline.c
     sha256/sha256.c
     types/byte_buffer.c types/cbor_data.c types/cbor_encoder.c types/cbor_decoder.c
     types/registry.c types/bytes_type.c types/psbt.c types/bip39.c
-    types/keypath.c types/hd_key.c types/multi_key.c types/output.c
+    types/keypath.c types/hd_key.c types/multi_key.c types/output.c types/payload_check.c
 )
 
 for src in "${SOURCES[@]}"; do
@@ -100,7 +102,7 @@ echo -e "${YELLOW}Building and running tests...${NC}"
 for test_file in "${TEST_FILES[@]}"; do
     test_name=$(basename "$test_file" .c)
     echo -e "  Building ${test_name}..."
-    gcc $CFLAGS $INCLUDES "$test_file" $SUPPORT_OBJS -Lsrc -lur_cov -lm -o "tests/${test_name}_cov" --coverage
+    gcc $CFLAGS $INCLUDES "$test_file" $SUPPORT_OBJS -Lsrc -lur_cov -lm -pthread -o "tests/${test_name}_cov" --coverage
 
     echo -e "  Running ${test_name}..."
     "./tests/${test_name}_cov" || true
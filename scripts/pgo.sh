@@ -0,0 +1,35 @@
+#!/bin/bash
+#
+# Profile-guided build of src/libur.a (`make pgo`).
+#
+#   1. build instrumented (UR_PGO=gen) and train on every test vector in
+#      tests/test_cases plus the synthetic fountain workload
+#      (scripts/pgo_workload.c);
+#   2. rebuild with the collected profile (UR_PGO=use) and rerun the tests.
+#
+# Extra make variables (e.g. UR_LTO=1 UR_NATIVE=1) are passed through to
+# both stages. Profiles land in build/pgo-profile/.
+#
+
+set -e
+
+PROJECT_ROOT="$(cd "$(dirname "$0")/.." && pwd)"
+cd "$PROJECT_ROOT"
+
+PROFILE_DIR="build/pgo-profile"
+CC="${CC:-gcc}"
+
+echo "=== PGO stage 1: instrumented build + training run ==="
+make clean
+rm -rf "$PROFILE_DIR"
+make UR_PGO=gen "$@" test
+mkdir -p build
+"$CC" -std=c99 -O2 -Isrc -fprofile-generate scripts/pgo_workload.c \
+    src/libur.a -o build/pgo_workload
+./build/pgo_workload
+
+echo "=== PGO stage 2: optimized build from profile ==="
+make clean
+make UR_PGO=use "$@" test
+
+echo "PGO build complete: src/libur.a"
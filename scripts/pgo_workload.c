@@ -0,0 +1,80 @@
+/*
+ * pgo_workload.c
+ *
+ * Synthetic fountain workload for the PGO training run (scripts/pgo.sh).
+ * The test vectors mostly exercise short, clean scans; this adds the
+ * steady-state hot paths of a long noisy one: multi-KB messages, dropped
+ * frames (so the decoder has to reduce mixed parts), and the encoder's
+ * mixing loop. Deterministic, so profiles are reproducible.
+ */
+
+#include "ur_decoder.h"
+#include "ur_encoder.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+static uint32_t lcg_state = 0x2545F491u;
+
+static uint32_t lcg_next(void) {
+  lcg_state = lcg_state * 1664525u + 1013904223u;
+  return lcg_state >> 8;
+}
+
+// Encode a bytes(n) payload and decode it while dropping drop_pct% of the
+// frames. Returns false if the decode does not complete.
+static bool run_scan(size_t payload_len, size_t max_fragment_len,
+                     unsigned drop_pct) {
+  size_t cbor_len = payload_len + 3;
+  uint8_t *cbor = malloc(cbor_len);
+  if (!cbor)
+    return false;
+  cbor[0] = 0x59; // bytes, 2-byte length
+  cbor[1] = (uint8_t)(payload_len >> 8);
+  cbor[2] = (uint8_t)payload_len;
+  for (size_t i = 3; i < cbor_len; i++)
+    cbor[i] = (uint8_t)lcg_next();
+
+  ur_encoder_t *encoder =
+      ur_encoder_new("bytes", cbor, cbor_len, max_fragment_len, 0, 10);
+  ur_decoder_t *decoder = ur_decoder_new();
+  ur_decoder_state_t state = UR_DECODER_PROCESSING;
+  size_t limit = ur_encoder_seq_len(encoder) * 20 + 100;
+
+  for (size_t sent = 0;
+       encoder && decoder && !ur_decoder_state_is_terminal(state) &&
+       sent < limit;
+       sent++) {
+    char *part = NULL;
+    if (!ur_encoder_next_part(encoder, &part))
+      break;
+    if (lcg_next() % 100 >= drop_pct)
+      state = ur_decoder_receive_part(decoder, part);
+    free(part);
+  }
+
+  ur_decoder_free(decoder);
+  ur_encoder_free(encoder);
+  free(cbor);
+  return state == UR_DECODER_OK;
+}
+
+int main(void) {
+  static const size_t payloads[] = {200, 1500, 8000, 30000};
+  static const size_t fragments[] = {60, 200, 500};
+  static const unsigned drops[] = {0, 25, 50};
+
+  int failures = 0;
+  for (size_t p = 0; p < sizeof(payloads) / sizeof(payloads[0]); p++) {
+    for (size_t f = 0; f < sizeof(fragments) / sizeof(fragments[0]); f++) {
+      for (size_t d = 0; d < sizeof(drops) / sizeof(drops[0]); d++) {
+        if (!run_scan(payloads[p], fragments[f], drops[d])) {
+          fprintf(stderr, "scan %zu/%zu/%u%% did not complete\n", payloads[p],
+                  fragments[f], drops[d]);
+          failures++;
+        }
+      }
+    }
+  }
+  return failures ? 1 : 0;
+}
@@ -92,20 +92,11 @@ static const int16_t lookup_table[] = {
     -1,  -1,  -1,  -1,  -1,  -1,  180, -1,  -1,  -1,  -1,  -1,  242, -1,  -1,
     -1};
 
-bool bytewords_encode(const uint8_t *data, size_t data_len, char **encoded) {
-  if (!data || !encoded || data_len == 0)
-    return false;
-
+size_t bytewords_encode_into(const uint8_t *data, size_t data_len, char *out) {
   uint32_t crc = crc32_calculate(data, data_len);
-  size_t total_len = data_len + 4;
 
   // MINIMAL style: 2 chars per byte (first + last character of word).
-  // Written byte-by-byte below, so skip the zero-init.
-  *encoded = safe_malloc_uninit(total_len * 2 + 1);
-  if (!*encoded)
-    return false;
-
-  char *pos = *encoded;
+  char *pos = out;
   for (size_t i = 0; i < data_len; i++) {
     const char *word = &bytewords_minimal[data[i] * 2];
     *pos++ = word[0];
@@ -118,8 +109,21 @@ bool bytewords_encode(const uint8_t *data, size_t data_len, char **encoded) {
     *pos++ = word[0];
     *pos++ = word[1];
   }
-  *pos = '\0';
+  return (size_t)(pos - out);
+}
+
+bool bytewords_encode(const uint8_t *data, size_t data_len, char **encoded) {
+  if (!data || !encoded || data_len == 0)
+    return false;
+
+  // Written byte-by-byte by bytewords_encode_into, so skip the zero-init.
+  size_t encoded_len = (data_len + 4) * 2;
+  *encoded = safe_malloc_uninit(encoded_len + 1);
+  if (!*encoded)
+    return false;
 
+  bytewords_encode_into(data, data_len, *encoded);
+  (*encoded)[encoded_len] = '\0';
   return true;
 }
 
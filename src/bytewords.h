@@ -1,6 +1,7 @@
 #ifndef BYTEWORDS_H
 #define BYTEWORDS_H
 
+#include "ur_export.h"
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
@@ -12,13 +13,25 @@
  * @param encoded Output encoded string (allocated)
  * @return true on success, false on error
  */
-bool bytewords_encode(const uint8_t *data, size_t data_len, char **encoded);
+UR_API bool bytewords_encode(const uint8_t *data, size_t data_len,
+                             char **encoded);
+
+/**
+ * Encode bytes to bytewords minimal into a caller buffer (with CRC32)
+ * @param data Data to encode
+ * @param data_len Length of data
+ * @param out Output buffer with room for 2 * (data_len + 4) chars; no NUL
+ * terminator is written
+ * @return Number of chars written
+ */
+UR_API size_t bytewords_encode_into(const uint8_t *data, size_t data_len,
+                                    char *out);
 
 /**
  * Free bytewords result
  * @param ptr Pointer to free (can be char* or uint8_t*)
  */
-void bytewords_free(void *ptr);
+UR_API void bytewords_free(void *ptr);
 
 /**
  * Raw bytewords minimal decode (no CRC32 validation) - for internal UR use
@@ -27,7 +40,7 @@ void bytewords_free(void *ptr);
  * @param decoded_len Output decoded length
  * @return true on success, false on error
  */
-bool bytewords_decode_raw(const char *encoded, uint8_t **decoded,
-                          size_t *decoded_len);
+UR_API bool bytewords_decode_raw(const char *encoded, uint8_t **decoded,
+                                 size_t *decoded_len);
 
 #endif // BYTEWORDS_H
@@ -27,11 +27,11 @@
 
 #include "crc32_slice_table.h"
 
-uint32_t crc32_calculate(const uint8_t *data, size_t length) {
+uint32_t crc32_update(uint32_t crc, const uint8_t *data, size_t length) {
   if (!data || length == 0)
-    return 0;
+    return crc;
 
-  uint32_t crc = 0xFFFFFFFFu;
+  crc = ~crc;
   size_t i = 0;
   for (; i + 8 <= length; i += 8) {
     uint32_t lo, hi;
@@ -57,11 +57,11 @@ static const uint32_t crc32_table[16] = {
     0x4db26158, 0x5005713c, 0xedb88320, 0xf00f9344, 0xd6d6a3e8, 0xcb61b38c,
     0x9b64c2b0, 0x86d3d2d4, 0xa00ae278, 0xbdbdf21c};
 
-uint32_t crc32_calculate(const uint8_t *data, size_t length) {
+uint32_t crc32_update(uint32_t crc, const uint8_t *data, size_t length) {
   if (!data || length == 0)
-    return 0;
+    return crc;
 
-  uint32_t crc = 0xFFFFFFFF;
+  crc = ~crc;
   for (size_t i = 0; i < length; i++) {
     crc = (crc >> 4) ^ crc32_table[(crc ^ data[i]) & 0x0F];
     crc = (crc >> 4) ^ crc32_table[(crc ^ (data[i] >> 4)) & 0x0F];
@@ -70,3 +70,7 @@ uint32_t crc32_calculate(const uint8_t *data, size_t length) {
 }
 
 #endif
+
+uint32_t crc32_calculate(const uint8_t *data, size_t length) {
+  return crc32_update(0, data, length);
+}
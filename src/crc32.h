@@ -1,6 +1,7 @@
 #ifndef CRC32_H
 #define CRC32_H
 
+#include "ur_export.h"
 #include <stddef.h>
 #include <stdint.h>
 
@@ -11,6 +12,17 @@
  * @param length Length of data in bytes
  * @return CRC32 checksum
  */
-uint32_t crc32_calculate(const uint8_t *data, size_t length);
+UR_API uint32_t crc32_calculate(const uint8_t *data, size_t length);
+
+/**
+ * Continue a CRC32 over the next chunk of a message, so a message can be
+ * checksummed in pieces: start from 0, feed every chunk in order, and the
+ * result equals crc32_calculate() over the concatenation
+ * @param crc CRC32 of the preceding chunks (0 for the first)
+ * @param data Pointer to the chunk
+ * @param length Length of the chunk in bytes
+ * @return CRC32 of everything fed so far
+ */
+UR_API uint32_t crc32_update(uint32_t crc, const uint8_t *data, size_t length);
 
 #endif // CRC32_H
\ No newline at end of file
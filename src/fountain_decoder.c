@@ -30,13 +30,19 @@ typedef struct {
   size_t capacity;
 } hash_set_t;
 
-// Queue for processing parts
+// Work queue for processing parts: a growable binary min-heap ordered by
+// degree (index count), FIFO among equal degrees. Simple and low-degree
+// parts come out first, since they unlock the most reductions.
 typedef struct {
-  decoder_part_t *parts;
-  size_t front;
-  size_t rear;
+  decoder_part_t part;
+  size_t seq; // Enqueue order, breaks degree ties
+} queued_part_t;
+
+typedef struct {
+  queued_part_t *items;
   size_t count;
   size_t capacity;
+  size_t next_seq;
 } part_queue_t;
 
 // Fountain decoder structure
@@ -45,31 +51,55 @@ struct fountain_decoder {
   part_indexes_t *last_part_indexes;
   size_t processed_parts_count;
   fountain_decoder_result_t *result;
-  part_indexes_t *expected_part_indexes;
+  size_t expected_part_count; // seq_len; 0 until the first part
   size_t expected_fragment_len;
   size_t expected_message_len;
   uint32_t expected_checksum;
 
   // Simple parts storage (key: single index, value: data)
   struct {
-    size_t *keys;
+    ur_index_t *keys;
     decoder_part_t *values;
-    size_t *value_lens;
-    size_t count;
-    size_t capacity;
+    ur_len_t *value_lens;
+    ur_index_t count;
+    ur_index_t capacity;
   } simple_parts;
 
+  // Output sink (fountain_decoder_set_sink). While sink.write is set,
+  // solved fragments are written there instead of to simple_parts, and
+  // sink_buf holds one fragment read back for a reduction or the checksum.
+  fountain_sink_t sink;
+  uint8_t *sink_buf;
+
+  // In-order prefix delivery: prefix_fragments fragments from index 0 have
+  // been handed to prefix_fn
+  fountain_prefix_fn prefix_fn;
+  void *prefix_ctx;
+  size_t prefix_fragments;
+
   // Hash-based mixed parts storage
   mixed_parts_hash_t *mixed_parts_hash;
 
+  // Weighted-progress partial credit, kept in step with mixed_parts_hash:
+  // mixed_scores[i] is the Q8.24 sum of 1/degree over the mixed parts that
+  // cover fragment i, mixed_score_sum the sum of those scores capped at
+  // MIXED_SCORE_CAP. Maintained on every add/reduce/remove so the weighted
+  // estimate is an O(1) read.
+  uint32_t *mixed_scores;
+  uint64_t mixed_score_sum;
+
   // Lightweight duplicate detection (stores only hashes, not full parts)
   hash_set_t received_fragments_hashes;
 
   // Processing queue
   part_queue_t queue;
 
+  // Bytes XOR'd or copied by the reduction cascade; fountain_decoder_step()
+  // meters its budget against this.
+  size_t work_bytes;
+
   // Cached degree sampler (avoids repeated allocation per fountain fragment)
-  random_sampler_t degree_sampler;
+  degree_sampler_t degree_sampler;
 
   // Duplicate detection: store last fragment sequence number
   uint32_t last_fragment_seq_num;
@@ -91,36 +121,46 @@ struct fountain_decoder {
 #define SIMPLE_PARTS_INITIAL_CAPACITY 4
 #define INDEXES_INITIAL_CAPACITY 4
 #define HASH_MIN_CAPACITY 64
-#define HASH_CAPACITY_MULTIPLIER 1
+#define MIXED_HASH_INITIAL_CAPACITY 8
 #define MAX_MIXED_PARTS 256 // Limit mixed parts to prevent memory explosion
 #define MAX_DUPLICATE_TRACKING 512 // Limit duplicate tracking set size
 
 #ifdef ENABLE_CROSS_REDUCTION
 #define CROSS_REDUCTION_MAX_ITERATIONS 7
 #endif
+// Weighted-progress scores are Q8.24; each fragment's credit caps at 0.75
+#define MIXED_SCORE_ONE (1u << 24)
+#define MIXED_SCORE_CAP (MIXED_SCORE_ONE / 4 * 3)
 #define FNV1A_OFFSET_BASIS 2166136261u
 #define FNV1A_PRIME 16777619u
 
-// Hash table for mixed parts - key is the set of indexes
-typedef struct hash_entry {
-  part_indexes_t key;
-  decoder_part_t value;
-  size_t key_hash; // Cached hash for fast collision filtering
-  struct hash_entry *next;
-} hash_entry_t;
-
+// Mixed parts table. Entries are dense: entry i owns keys[i], its cached
+// hash and block i of the payload slab (block_len bytes, one fragment), so
+// a full walk is a linear scan. An open-addressing index (linear probing,
+// power-of-two size, kept at most 3/4 full) maps a key to its entry; each
+// slot holds the entry number + 1, or 0 when empty.
 struct mixed_parts_hash {
-  hash_entry_t **buckets;
+  part_indexes_t *keys;
+  uint32_t *key_hashes; // Cached hash for fast collision filtering
+  uint8_t *slab;
+#ifdef UR_FOUNTAIN_DEFERRED_XOR
+  // Solved fragments not yet XOR'd out of block i: the block holds the XOR
+  // of the fragments in keys[i] and in pending[i].
+  part_indexes_t *pending;
+#endif
+  size_t block_len;
   size_t count;
   size_t capacity;
+  uint32_t *slots;
+  size_t slot_capacity;
 };
 
 // Hash function for part indexes using FNV-1a algorithm
-static size_t hash_indexes(const part_indexes_t *indexes) {
+static uint32_t hash_indexes(const part_indexes_t *indexes) {
   if (!indexes || indexes->count == 0)
     return 0;
 
-  size_t hash = FNV1A_OFFSET_BASIS;
+  uint32_t hash = FNV1A_OFFSET_BASIS;
   for (size_t i = 0; i < indexes->count; i++) {
     hash ^= indexes->indexes[i];
     hash *= FNV1A_PRIME;
@@ -130,20 +170,6 @@ static size_t hash_indexes(const part_indexes_t *indexes) {
 
 // Hash set operations for lightweight duplicate detection
 
-// Initialize hash set
-static bool hash_set_init(hash_set_t *set, size_t capacity) {
-  if (!set || capacity == 0)
-    return false;
-
-  set->hashes = safe_malloc(capacity * sizeof(uint32_t));
-  if (!set->hashes)
-    return false;
-
-  set->count = 0;
-  set->capacity = capacity;
-  return true;
-}
-
 // Free hash set
 static void hash_set_free(hash_set_t *set) {
   if (!set)
@@ -194,9 +220,11 @@ static bool hash_set_add(hash_set_t *set, uint32_t hash) {
     return false;
   }
 
-  // Expand if needed (but respect MAX_DUPLICATE_TRACKING limit)
+  // Allocated on first use; expand if needed (but respect
+  // MAX_DUPLICATE_TRACKING limit)
   if (set->count >= set->capacity) {
-    size_t new_capacity = set->capacity * 2;
+    size_t new_capacity =
+        set->capacity == 0 ? HASH_MIN_CAPACITY : set->capacity * 2;
     if (new_capacity > MAX_DUPLICATE_TRACKING) {
       new_capacity = MAX_DUPLICATE_TRACKING;
     }
@@ -218,100 +246,318 @@ static bool hash_set_add(hash_set_t *set, uint32_t hash) {
   return true;
 }
 
-// Initialize hash table with dynamic capacity
-static bool mixed_hash_init(mixed_parts_hash_t *hash, size_t capacity) {
-  if (!hash || capacity == 0)
-    return false;
+// Initialize an empty mixed parts table; storage is allocated on first put
+static void mixed_hash_init(mixed_parts_hash_t *hash, size_t block_len) {
+  *hash = (mixed_parts_hash_t){0};
+  hash->block_len = block_len;
+}
 
-  hash->buckets = calloc(capacity, sizeof(hash_entry_t *));
-  if (!hash->buckets)
-    return false;
+// Free mixed parts table
+static void mixed_hash_free(mixed_parts_hash_t *hash) {
+  if (!hash)
+    return;
+
+  for (size_t i = 0; i < hash->count; i++) {
+    free(hash->keys[i].indexes);
+#ifdef UR_FOUNTAIN_DEFERRED_XOR
+    free(hash->pending[i].indexes);
+#endif
+  }
+  safe_free(hash->keys);
+  safe_free(hash->key_hashes);
+  safe_free(hash->slab);
+#ifdef UR_FOUNTAIN_DEFERRED_XOR
+  safe_free(hash->pending);
+#endif
+  safe_free(hash->slots);
+  hash->count = 0;
+  hash->capacity = 0;
+  hash->slot_capacity = 0;
+}
 
+// Remove every entry but keep the arrays, slab and index for reuse
+static void mixed_hash_clear(mixed_parts_hash_t *hash) {
+  for (size_t i = 0; i < hash->count; i++) {
+    free(hash->keys[i].indexes);
+#ifdef UR_FOUNTAIN_DEFERRED_XOR
+    free(hash->pending[i].indexes);
+#endif
+  }
   hash->count = 0;
-  hash->capacity = capacity;
-  return true;
+  if (hash->slots) {
+    memset(hash->slots, 0, hash->slot_capacity * sizeof(uint32_t));
+  }
 }
 
-// Free hash table
-static void mixed_hash_free(mixed_parts_hash_t *hash) {
-  if (!hash || !hash->buckets)
+// Bytes held by the table's arrays, slab and index
+static size_t mixed_hash_footprint(const mixed_parts_hash_t *hash) {
+  size_t entry_size = sizeof(part_indexes_t) + sizeof(uint32_t);
+#ifdef UR_FOUNTAIN_DEFERRED_XOR
+  entry_size += sizeof(part_indexes_t);
+#endif
+  return hash->capacity * (entry_size + hash->block_len) +
+         hash->slot_capacity * sizeof(uint32_t);
+}
+
+// Set the payload length of an empty table. The slab is sized in blocks,
+// so a different length drops it and the dense arrays restart from the
+// initial capacity on the next put (the index is kept).
+static void mixed_hash_set_block_len(mixed_parts_hash_t *hash,
+                                     size_t block_len) {
+  if (hash->block_len == block_len)
     return;
 
-  for (size_t i = 0; i < hash->capacity; i++) {
-    hash_entry_t *entry = hash->buckets[i];
-    while (entry) {
-      hash_entry_t *next = entry->next;
-      decoder_part_free(&entry->value);
-      if (entry->key.indexes) {
-        free(entry->key.indexes);
-      }
-      free(entry);
-      entry = next;
+  safe_free(hash->slab);
+  hash->block_len = block_len;
+  hash->capacity = 0;
+}
+
+static uint8_t *mixed_hash_block(const mixed_parts_hash_t *hash,
+                                 size_t entry) {
+  return hash->slab + entry * hash->block_len;
+}
+
+// View an entry as a decoder part (borrowed; never freed by the caller)
+static decoder_part_t mixed_hash_part(const mixed_parts_hash_t *hash,
+                                      size_t entry) {
+  return (decoder_part_t){.indexes = hash->keys[entry],
+                          .data = mixed_hash_block(hash, entry),
+                          .data_len = (ur_len_t)hash->block_len};
+}
+
+static void mixed_hash_link(mixed_parts_hash_t *hash, size_t entry) {
+  size_t mask = hash->slot_capacity - 1;
+  size_t slot = hash->key_hashes[entry] & mask;
+  while (hash->slots[slot]) {
+    slot = (slot + 1) & mask;
+  }
+  hash->slots[slot] = (uint32_t)entry + 1;
+}
+
+// Slot holding key, or the empty slot where it would be linked
+static size_t mixed_hash_find_slot(const mixed_parts_hash_t *hash,
+                                   const part_indexes_t *key,
+                                   uint32_t key_hash) {
+  size_t mask = hash->slot_capacity - 1;
+  size_t slot = key_hash & mask;
+  while (hash->slots[slot]) {
+    size_t entry = hash->slots[slot] - 1;
+    if (hash->key_hashes[entry] == key_hash &&
+        part_indexes_equal(&hash->keys[entry], key)) {
+      break;
     }
+    slot = (slot + 1) & mask;
   }
+  return slot;
+}
 
-  safe_free(hash->buckets);
-  hash->count = 0;
+static size_t mixed_hash_slot_of(const mixed_parts_hash_t *hash,
+                                 size_t entry) {
+  size_t mask = hash->slot_capacity - 1;
+  size_t slot = hash->key_hashes[entry] & mask;
+  while (hash->slots[slot] != entry + 1) {
+    slot = (slot + 1) & mask;
+  }
+  return slot;
 }
 
-// Add or update entry in hash table
-static bool mixed_hash_put(mixed_parts_hash_t *hash, const part_indexes_t *key,
-                           const decoder_part_t *value) {
-  if (!hash || !hash->buckets || !key || !value || hash->capacity == 0)
-    return false;
+// Empty a slot with backward-shift deletion, so probe chains never need
+// tombstones: each following entry moves into the hole unless its home
+// slot lies cyclically after the hole.
+static void mixed_hash_unlink(mixed_parts_hash_t *hash, size_t slot) {
+  size_t mask = hash->slot_capacity - 1;
+  size_t hole = slot;
+  for (size_t s = (slot + 1) & mask; hash->slots[s]; s = (s + 1) & mask) {
+    size_t home = hash->key_hashes[hash->slots[s] - 1] & mask;
+    if (((s - home) & mask) >= ((s - hole) & mask)) {
+      hash->slots[hole] = hash->slots[s];
+      hole = s;
+    }
+  }
+  hash->slots[hole] = 0;
+}
+
+// Release an entry already unlinked from the index, moving the last entry
+// into its place to keep the arrays dense
+static void mixed_hash_drop(mixed_parts_hash_t *hash, size_t entry) {
+  free(hash->keys[entry].indexes);
+#ifdef UR_FOUNTAIN_DEFERRED_XOR
+  free(hash->pending[entry].indexes);
+#endif
+  size_t last = --hash->count;
+  if (entry == last)
+    return;
+
+  hash->slots[mixed_hash_slot_of(hash, last)] = (uint32_t)entry + 1;
+  hash->keys[entry] = hash->keys[last];
+#ifdef UR_FOUNTAIN_DEFERRED_XOR
+  hash->pending[entry] = hash->pending[last];
+#endif
+  hash->key_hashes[entry] = hash->key_hashes[last];
+  if (hash->block_len > 0) {
+    memcpy(mixed_hash_block(hash, entry), mixed_hash_block(hash, last),
+           hash->block_len);
+  }
+}
+
+// Remove an entry. The last entry takes its number, so a walk that removes
+// entry i must look at entry i again.
+static void mixed_hash_remove(mixed_parts_hash_t *hash, size_t entry) {
+  mixed_hash_unlink(hash, mixed_hash_slot_of(hash, entry));
+  mixed_hash_drop(hash, entry);
+}
+
+// Make room for one more entry: the dense arrays double (up to
+// MAX_MIXED_PARTS) and the index doubles and is rebuilt past 3/4 load.
+static bool mixed_hash_reserve(mixed_parts_hash_t *hash) {
+  if (hash->count >= hash->capacity) {
+    size_t new_capacity = hash->capacity == 0 ? MIXED_HASH_INITIAL_CAPACITY
+                                              : hash->capacity * 2;
+    if (new_capacity > MAX_MIXED_PARTS)
+      new_capacity = MAX_MIXED_PARTS;
+    if (new_capacity <= hash->count ||
+        (hash->block_len > 0 && new_capacity > SIZE_MAX / hash->block_len))
+      return false;
+
+    // As in add_simple_part, commit each array before the next realloc
+    part_indexes_t *new_keys =
+        safe_realloc(hash->keys, new_capacity * sizeof(part_indexes_t));
+    if (!new_keys)
+      return false;
+    hash->keys = new_keys;
+
+    uint32_t *new_hashes =
+        safe_realloc(hash->key_hashes, new_capacity * sizeof(uint32_t));
+    if (!new_hashes)
+      return false;
+    hash->key_hashes = new_hashes;
+
+#ifdef UR_FOUNTAIN_DEFERRED_XOR
+    part_indexes_t *new_pending =
+        safe_realloc(hash->pending, new_capacity * sizeof(part_indexes_t));
+    if (!new_pending)
+      return false;
+    hash->pending = new_pending;
+#endif
+
+    if (hash->block_len > 0) {
+      uint8_t *new_slab =
+          safe_realloc(hash->slab, new_capacity * hash->block_len);
+      if (!new_slab)
+        return false;
+      hash->slab = new_slab;
+    }
 
-  size_t key_hash = hash_indexes(key);
-  size_t bucket = key_hash % hash->capacity;
+    hash->capacity = new_capacity;
+  }
 
-  // Check if already exists
-  hash_entry_t *entry = hash->buckets[bucket];
-  while (entry) {
-    // Fast path: compare cached hash first
-    if (entry->key_hash == key_hash && part_indexes_equal(&entry->key, key)) {
-      // Already exists, don't add duplicate
+  if ((hash->count + 1) * 4 > hash->slot_capacity * 3) {
+    size_t new_slot_capacity = hash->slot_capacity == 0
+                                   ? MIXED_HASH_INITIAL_CAPACITY * 2
+                                   : hash->slot_capacity * 2;
+    uint32_t *new_slots = safe_malloc(new_slot_capacity * sizeof(uint32_t));
+    if (!new_slots)
       return false;
+
+    free(hash->slots);
+    hash->slots = new_slots;
+    hash->slot_capacity = new_slot_capacity;
+    for (size_t i = 0; i < hash->count; i++) {
+      mixed_hash_link(hash, i);
     }
-    entry = entry->next;
   }
 
-  hash_entry_t *new_entry = calloc(1, sizeof(hash_entry_t));
-  if (!new_entry)
-    return false;
+  return true;
+}
 
-  new_entry->key_hash = key_hash; // Cache the hash
+// Add an entry, copying the key and one block of data. Returns false if
+// the key is already present or on allocation failure.
+static bool mixed_hash_put(mixed_parts_hash_t *hash, const part_indexes_t *key,
+                           const uint8_t *data) {
+  if (!hash || !key || (hash->block_len > 0 && !data))
+    return false;
 
-  if (!part_indexes_copy(key, &new_entry->key)) {
-    free(new_entry);
+  if (!mixed_hash_reserve(hash))
     return false;
-  }
 
-  if (!decoder_part_copy(value, &new_entry->value)) {
-    if (new_entry->key.indexes) {
-      free(new_entry->key.indexes);
-    }
-    free(new_entry);
+  uint32_t key_hash = hash_indexes(key);
+  size_t slot = mixed_hash_find_slot(hash, key, key_hash);
+  if (hash->slots[slot])
+    return false; // Already exists, don't add duplicate
+
+  size_t entry = hash->count;
+  hash->keys[entry] = (part_indexes_t){0};
+  if (!part_indexes_copy(key, &hash->keys[entry]))
     return false;
+  hash->key_hashes[entry] = key_hash;
+#ifdef UR_FOUNTAIN_DEFERRED_XOR
+  hash->pending[entry] = (part_indexes_t){0};
+#endif
+  if (hash->block_len > 0) {
+    memcpy(mixed_hash_block(hash, entry), data, hash->block_len);
   }
 
-  new_entry->next = hash->buckets[bucket];
-  hash->buckets[bucket] = new_entry;
+  hash->slots[slot] = (uint32_t)entry + 1;
   hash->count++;
+  return true;
+}
 
+// Replace an entry's key, taking ownership of new_key's array. If another
+// entry already has that key this one is redundant: it is removed and
+// false is returned.
+static bool mixed_hash_rekey(mixed_parts_hash_t *hash, size_t entry,
+                             part_indexes_t *new_key) {
+  mixed_hash_unlink(hash, mixed_hash_slot_of(hash, entry));
+  free(hash->keys[entry].indexes);
+  hash->keys[entry] = *new_key;
+  *new_key = (part_indexes_t){0};
+  hash->key_hashes[entry] = hash_indexes(&hash->keys[entry]);
+
+  size_t slot =
+      mixed_hash_find_slot(hash, &hash->keys[entry], hash->key_hashes[entry]);
+  if (hash->slots[slot]) {
+    mixed_hash_drop(hash, entry);
+    return false;
+  }
+  hash->slots[slot] = (uint32_t)entry + 1;
   return true;
 }
 
+// Add (sign > 0) or remove (sign < 0) one mixed part's contribution to the
+// weighted-progress scores. Each covered fragment gets 1/degree; the same
+// truncated Q8.24 step is used both ways so removal is exact.
+static void mixed_scores_update(fountain_decoder_t *decoder,
+                                const part_indexes_t *key, int sign) {
+  if (!decoder->mixed_scores || !key || key->count == 0)
+    return;
+
+  size_t parts = decoder->expected_part_count;
+  uint32_t step = MIXED_SCORE_ONE / (uint32_t)key->count;
+  for (size_t k = 0; k < key->count; k++) {
+    size_t index = key->indexes[k];
+    if (index >= parts)
+      continue;
+    uint32_t old_score = decoder->mixed_scores[index];
+    uint32_t new_score = sign > 0 ? old_score + step : old_score - step;
+    decoder->mixed_scores[index] = new_score;
+    decoder->mixed_score_sum -=
+        old_score < MIXED_SCORE_CAP ? old_score : MIXED_SCORE_CAP;
+    decoder->mixed_score_sum +=
+        new_score < MIXED_SCORE_CAP ? new_score : MIXED_SCORE_CAP;
+  }
+}
+
 static bool queue_init(part_queue_t *queue, size_t capacity) {
   if (!queue || capacity == 0)
     return false;
 
-  queue->parts = safe_malloc(capacity * sizeof(decoder_part_t));
-  if (!queue->parts)
+  queue->items = safe_malloc(capacity * sizeof(queued_part_t));
+  if (!queue->items)
     return false;
 
-  queue->front = 0;
-  queue->rear = 0;
   queue->count = 0;
   queue->capacity = capacity;
+  queue->next_seq = 0;
 
   return true;
 }
@@ -320,12 +566,11 @@ static void queue_free(part_queue_t *queue) {
   if (!queue)
     return;
 
-  if (queue->parts) {
+  if (queue->items) {
     for (size_t i = 0; i < queue->count; i++) {
-      size_t idx = (queue->front + i) % queue->capacity;
-      decoder_part_free(&queue->parts[idx]);
+      decoder_part_free(&queue->items[i].part);
     }
-    free(queue->parts);
+    free(queue->items);
   }
 
   memset(queue, 0, sizeof(part_queue_t));
@@ -340,13 +585,40 @@ static void decoder_part_move(decoder_part_t *src, decoder_part_t *dst) {
   *src = (decoder_part_t){0};
 }
 
+// Heap order: lower degree first, then earlier enqueue.
+static bool queue_item_before(const queued_part_t *a, const queued_part_t *b) {
+  if (a->part.indexes.count != b->part.indexes.count)
+    return a->part.indexes.count < b->part.indexes.count;
+  return a->seq < b->seq;
+}
+
 static bool queue_enqueue(part_queue_t *queue, decoder_part_t *part) {
-  if (!queue || !part || queue->count >= queue->capacity)
+  if (!queue || !part)
     return false;
 
-  decoder_part_move(part, &queue->parts[queue->rear]);
-  queue->rear = (queue->rear + 1) % queue->capacity;
-  queue->count++;
+  if (queue->count >= queue->capacity) {
+    size_t new_capacity =
+        queue->capacity == 0 ? QUEUE_INITIAL_CAPACITY : queue->capacity * 2;
+    queued_part_t *new_items =
+        safe_realloc(queue->items, new_capacity * sizeof(queued_part_t));
+    if (!new_items)
+      return false;
+    queue->items = new_items;
+    queue->capacity = new_capacity;
+  }
+
+  // Sift up from the new leaf
+  queued_part_t item = {*part, queue->next_seq++};
+  *part = (decoder_part_t){0};
+  size_t i = queue->count++;
+  while (i > 0) {
+    size_t parent = (i - 1) / 2;
+    if (!queue_item_before(&item, &queue->items[parent]))
+      break;
+    queue->items[i] = queue->items[parent];
+    i = parent;
+  }
+  queue->items[i] = item;
 
   return true;
 }
@@ -355,9 +627,25 @@ static bool queue_dequeue(part_queue_t *queue, decoder_part_t *part) {
   if (!queue || !part || queue->count == 0)
     return false;
 
-  decoder_part_move(&queue->parts[queue->front], part);
-  queue->front = (queue->front + 1) % queue->capacity;
-  queue->count--;
+  decoder_part_move(&queue->items[0].part, part);
+
+  // Sift the last leaf down from the root
+  queued_part_t item = queue->items[--queue->count];
+  size_t i = 0;
+  for (;;) {
+    size_t child = 2 * i + 1;
+    if (child >= queue->count)
+      break;
+    if (child + 1 < queue->count &&
+        queue_item_before(&queue->items[child + 1], &queue->items[child]))
+      child++;
+    if (!queue_item_before(&queue->items[child], &item))
+      break;
+    queue->items[i] = queue->items[child];
+    i = child;
+  }
+  if (queue->count > 0)
+    queue->items[i] = item;
 
   return true;
 }
@@ -429,7 +717,7 @@ void part_indexes_free(part_indexes_t *indexes) {
   }
 }
 
-bool part_indexes_add(part_indexes_t *indexes, size_t index) {
+bool part_indexes_add(part_indexes_t *indexes, ur_index_t index) {
   if (!indexes)
     return false;
 
@@ -449,10 +737,12 @@ bool part_indexes_add(part_indexes_t *indexes, size_t index) {
   // 'left' is now the insertion point
 
   if (indexes->count >= indexes->capacity) {
-    size_t new_capacity = indexes->capacity == 0 ? INDEXES_INITIAL_CAPACITY
-                                                 : indexes->capacity * 2;
-    size_t *new_indexes =
-        safe_realloc(indexes->indexes, sizeof(size_t) * new_capacity);
+    ur_index_t new_capacity =
+        ur_index_grow(indexes->capacity, INDEXES_INITIAL_CAPACITY);
+    if (new_capacity <= indexes->count)
+      return false;
+    ur_index_t *new_indexes =
+        safe_realloc(indexes->indexes, sizeof(ur_index_t) * new_capacity);
     if (!new_indexes)
       return false;
 
@@ -469,7 +759,7 @@ bool part_indexes_add(part_indexes_t *indexes, size_t index) {
   return true;
 }
 
-bool part_indexes_contains(const part_indexes_t *indexes, size_t index) {
+bool part_indexes_contains(const part_indexes_t *indexes, ur_index_t index) {
   if (!indexes || indexes->count == 0)
     return false;
 
@@ -508,6 +798,51 @@ fountain_decoder_t *fountain_decoder_new(void) {
   return decoder;
 }
 
+// Close and drop the output sink, if any
+static void sink_release(fountain_decoder_t *decoder) {
+  if (decoder->sink.close) {
+    decoder->sink.close(decoder->sink.ctx);
+  }
+  decoder->sink = (fountain_sink_t){0};
+  safe_free(decoder->sink_buf);
+}
+
+bool fountain_decoder_set_sink(fountain_decoder_t *decoder,
+                               const fountain_sink_t *sink) {
+  if (!sink)
+    return false;
+  if (!decoder || decoder->expected_part_count != 0 || !sink->write ||
+      !sink->read) {
+    if (sink->close) {
+      sink->close(sink->ctx);
+    }
+    return false;
+  }
+
+  sink_release(decoder);
+  decoder->sink = *sink;
+  return true;
+}
+
+void fountain_decoder_set_prefix_callback(fountain_decoder_t *decoder,
+                                          fountain_prefix_fn fn, void *ctx) {
+  if (!decoder)
+    return;
+  decoder->prefix_fn = fn;
+  decoder->prefix_ctx = ctx;
+}
+
+static void simple_parts_free(fountain_decoder_t *decoder) {
+  for (size_t i = 0; i < decoder->simple_parts.capacity; i++) {
+    decoder_part_free(&decoder->simple_parts.values[i]);
+  }
+  safe_free(decoder->simple_parts.keys);
+  safe_free(decoder->simple_parts.values);
+  safe_free(decoder->simple_parts.value_lens);
+  decoder->simple_parts.count = 0;
+  decoder->simple_parts.capacity = 0;
+}
+
 void fountain_decoder_free(fountain_decoder_t *decoder) {
   if (!decoder)
     return;
@@ -520,10 +855,6 @@ void fountain_decoder_free(fountain_decoder_t *decoder) {
     part_indexes_free(decoder->last_part_indexes);
   }
 
-  if (decoder->expected_part_indexes) {
-    part_indexes_free(decoder->expected_part_indexes);
-  }
-
   if (decoder->result) {
     if (decoder->result->data) {
       free(decoder->result->data);
@@ -531,37 +862,131 @@ void fountain_decoder_free(fountain_decoder_t *decoder) {
     free(decoder->result);
   }
 
-  if (decoder->simple_parts.keys)
-    free(decoder->simple_parts.keys);
-  if (decoder->simple_parts.value_lens)
-    free(decoder->simple_parts.value_lens);
-  if (decoder->simple_parts.values) {
-    for (size_t i = 0; i < decoder->simple_parts.count; i++) {
-      decoder_part_free(&decoder->simple_parts.values[i]);
-    }
-    free(decoder->simple_parts.values);
-  }
+  simple_parts_free(decoder);
+  sink_release(decoder);
 
   // Free hash table for mixed parts
   if (decoder->mixed_parts_hash) {
     mixed_hash_free(decoder->mixed_parts_hash);
     safe_free(decoder->mixed_parts_hash);
   }
+  safe_free(decoder->mixed_scores);
 
   // Free hash set for duplicate detection
   hash_set_free(&decoder->received_fragments_hashes);
 
   // Free cached degree sampler
-  random_sampler_free(&decoder->degree_sampler);
+  degree_sampler_free(&decoder->degree_sampler);
 
   queue_free(&decoder->queue);
 
   free(decoder);
 }
 
+// Bytes held by the simple-part arrays and the fragment buffers in them
+static size_t simple_parts_footprint(const fountain_decoder_t *decoder) {
+  size_t bytes = decoder->simple_parts.capacity *
+                 (sizeof(ur_index_t) + sizeof(decoder_part_t) +
+                  sizeof(ur_len_t));
+  for (size_t i = 0; i < decoder->simple_parts.capacity; i++) {
+    const decoder_part_t *p = &decoder->simple_parts.values[i];
+    bytes += p->data_len + p->indexes.capacity * sizeof(ur_index_t);
+  }
+  return bytes;
+}
+
+void fountain_decoder_reset(fountain_decoder_t *decoder,
+                            size_t shrink_threshold) {
+  if (!decoder)
+    return;
+
+  if (decoder->result) {
+    free(decoder->result->data);
+    free(decoder->result);
+    decoder->result = NULL;
+  }
+
+  sink_release(decoder);
+  decoder->prefix_fn = NULL;
+  decoder->prefix_ctx = NULL;
+  decoder->prefix_fragments = 0;
+
+  // Queued parts are dropped; the heap array is kept
+  for (size_t i = 0; i < decoder->queue.count; i++) {
+    decoder_part_free(&decoder->queue.items[i].part);
+  }
+  decoder->queue.count = 0;
+  decoder->queue.next_seq = 0;
+
+  // Simple parts keep their slots' fragment buffers, which add_simple_part
+  // refills in place
+  decoder->simple_parts.count = 0;
+  if (decoder->mixed_parts_hash) {
+    mixed_hash_clear(decoder->mixed_parts_hash);
+  }
+  if (decoder->mixed_scores) {
+    memset(decoder->mixed_scores, 0,
+           decoder->degree_sampler.count * sizeof(uint32_t));
+  }
+  decoder->mixed_score_sum = 0;
+
+  part_indexes_clear(&decoder->received_part_indexes);
+  part_indexes_clear(decoder->last_part_indexes);
+  decoder->received_fragments_hashes.count = 0;
+
+  decoder->processed_parts_count = 0;
+  decoder->expected_part_count = 0;
+  decoder->expected_fragment_len = 0;
+  decoder->expected_message_len = 0;
+  decoder->expected_checksum = 0;
+  decoder->work_bytes = 0;
+  decoder->last_fragment_seq_num = 0;
+  decoder->has_received_fragment = false;
+#ifdef DEBUG_STATS
+  decoder->maximum_mixed_parts = 0;
+  decoder->mixed_from_fragments = 0;
+  decoder->mixed_from_reduction = 0;
+  decoder->mixed_from_cross_reduction = 0;
+  decoder->mixed_parts_useful = 0;
+#endif
+
+  if (shrink_threshold == 0)
+    return;
+
+  // Release whichever structures grew past the threshold; each regrows
+  // from its initial capacity on demand
+  if (simple_parts_footprint(decoder) > shrink_threshold) {
+    simple_parts_free(decoder);
+  }
+  if (decoder->mixed_parts_hash &&
+      mixed_hash_footprint(decoder->mixed_parts_hash) > shrink_threshold) {
+    mixed_hash_free(decoder->mixed_parts_hash);
+  }
+  if (decoder->degree_sampler.count *
+          (sizeof(*decoder->degree_sampler.probs) +
+           sizeof(*decoder->degree_sampler.aliases) + sizeof(uint32_t)) >
+      shrink_threshold) {
+    degree_sampler_free(&decoder->degree_sampler);
+    safe_free(decoder->mixed_scores);
+  }
+  if (decoder->queue.capacity * sizeof(queued_part_t) > shrink_threshold) {
+    safe_free(decoder->queue.items);
+    decoder->queue.capacity = 0;
+  }
+  if (decoder->received_fragments_hashes.capacity * sizeof(uint32_t) >
+      shrink_threshold) {
+    hash_set_free(&decoder->received_fragments_hashes);
+  }
+  if (decoder->received_part_indexes.capacity * sizeof(ur_index_t) >
+      shrink_threshold) {
+    safe_free(decoder->received_part_indexes.indexes);
+    decoder->received_part_indexes.capacity = 0;
+  }
+}
+
 static bool create_decoder_part_from_encoder_part(
     fountain_encoder_part_t *const encoder_part,
-    decoder_part_t *const decoder_part, random_sampler_t *cached_sampler) {
+    decoder_part_t *const decoder_part, degree_sampler_t *cached_sampler) {
   if (!encoder_part || !decoder_part) {
     return false;
   }
@@ -577,7 +1002,7 @@ static bool create_decoder_part_from_encoder_part(
   if (encoder_part->data && encoder_part->data_len > 0) {
     // Move data from encoder_part instead of copying
     decoder_part->data = encoder_part->data;
-    decoder_part->data_len = encoder_part->data_len;
+    decoder_part->data_len = (ur_len_t)encoder_part->data_len;
     encoder_part->data = NULL;
     encoder_part->data_len = 0;
   }
@@ -595,18 +1020,84 @@ static bool is_simple_part(const decoder_part_t *const part) {
   return part && part->indexes.count == 1;
 }
 
-static size_t get_part_index(const decoder_part_t *const part) {
+static ur_index_t get_part_index(const decoder_part_t *const part) {
   if (!part || part->indexes.count == 0)
     return 0;
   return part->indexes.indexes[0];
 }
 
+static bool has_sink(const fountain_decoder_t *decoder) {
+  return decoder->sink.write != NULL;
+}
+
+// Where fragment index lies in the message: returns its length with the
+// last fragment's padding trimmed (0 past the end) and sets *offset
+static size_t fragment_span(const fountain_decoder_t *decoder, size_t index,
+                            size_t *offset) {
+  *offset = index * decoder->expected_fragment_len;
+  if (*offset >= decoder->expected_message_len)
+    return 0;
+  size_t len = decoder->expected_message_len - *offset;
+  return len < decoder->expected_fragment_len ? len
+                                              : decoder->expected_fragment_len;
+}
+
+// A sink that cannot store or return a solved fragment leaves the message
+// undecodable, so the decode ends with an error result
+static void fail_in_sink(fountain_decoder_t *const decoder) {
+  if (decoder->result)
+    return;
+  decoder->result = safe_malloc(sizeof(fountain_decoder_result_t));
+  if (decoder->result) {
+    decoder->result->data = NULL;
+    decoder->result->data_len = 0;
+    decoder->result->is_success = false;
+    decoder->result->is_error = true;
+  }
+}
+
+// Payload of a solved fragment: its stored simple part or, with an output
+// sink, the fragment read back into sink_buf (valid until the next read).
+// NULL if it is not stored or the read fails, which ends the decode.
+static const uint8_t *solved_fragment_data(fountain_decoder_t *decoder,
+                                           ur_index_t index) {
+  if (has_sink(decoder)) {
+    size_t offset;
+    size_t len = fragment_span(decoder, index, &offset);
+    if (len > 0 && !decoder->sink.read(decoder->sink.ctx, offset,
+                                       decoder->sink_buf, len)) {
+      fail_in_sink(decoder);
+      return NULL;
+    }
+    memset(decoder->sink_buf + len, 0, decoder->expected_fragment_len - len);
+    return decoder->sink_buf;
+  }
+
+  for (size_t i = 0; i < decoder->simple_parts.count; i++) {
+    if (decoder->simple_parts.keys[i] == index)
+      return decoder->simple_parts.values[i].data;
+  }
+  return NULL;
+}
+
 static bool add_simple_part(fountain_decoder_t *const decoder,
                             const decoder_part_t *const part) {
   if (!decoder || !part || !is_simple_part(part))
     return false;
 
-  size_t index = get_part_index(part);
+  ur_index_t index = get_part_index(part);
+
+  // With a sink the fragment goes straight to its place in the message
+  if (has_sink(decoder)) {
+    size_t offset;
+    size_t len = fragment_span(decoder, index, &offset);
+    if (len > 0 &&
+        !decoder->sink.write(decoder->sink.ctx, offset, part->data, len)) {
+      fail_in_sink(decoder);
+      return false;
+    }
+    return true;
+  }
 
   for (size_t i = 0; i < decoder->simple_parts.count; i++) {
     if (decoder->simple_parts.keys[i] == index) {
@@ -615,16 +1106,17 @@ static bool add_simple_part(fountain_decoder_t *const decoder,
   }
 
   if (decoder->simple_parts.count >= decoder->simple_parts.capacity) {
-    size_t new_capacity = decoder->simple_parts.capacity == 0
-                              ? SIMPLE_PARTS_INITIAL_CAPACITY
-                              : decoder->simple_parts.capacity * 2;
+    ur_index_t new_capacity = ur_index_grow(decoder->simple_parts.capacity,
+                                            SIMPLE_PARTS_INITIAL_CAPACITY);
+    if (new_capacity <= decoder->simple_parts.count)
+      return false;
 
     // Realloc one field at a time, committing each to the struct before the
     // next attempt. safe_realloc frees the old block on success, so if a
     // later realloc fails we must never leave the struct pointing at a
     // freed block.
-    size_t *new_keys =
-        safe_realloc(decoder->simple_parts.keys, sizeof(size_t) * new_capacity);
+    ur_index_t *new_keys = safe_realloc(decoder->simple_parts.keys,
+                                        sizeof(ur_index_t) * new_capacity);
     if (!new_keys)
       return false;
     decoder->simple_parts.keys = new_keys;
@@ -635,8 +1127,8 @@ static bool add_simple_part(fountain_decoder_t *const decoder,
       return false;
     decoder->simple_parts.values = new_values;
 
-    size_t *new_lens = safe_realloc(decoder->simple_parts.value_lens,
-                                    sizeof(size_t) * new_capacity);
+    ur_len_t *new_lens = safe_realloc(decoder->simple_parts.value_lens,
+                                      sizeof(ur_len_t) * new_capacity);
     if (!new_lens)
       return false;
     decoder->simple_parts.value_lens = new_lens;
@@ -652,9 +1144,15 @@ static bool add_simple_part(fountain_decoder_t *const decoder,
     decoder->simple_parts.capacity = new_capacity;
   }
 
+  // Slots past count may still hold buffers kept by fountain_decoder_reset();
+  // a fragment of the same length is copied into them in place
   decoder_part_t *stored_part =
       &decoder->simple_parts.values[decoder->simple_parts.count];
-  if (!decoder_part_copy(part, stored_part)) {
+  if (stored_part->data && stored_part->data_len == part->data_len) {
+    if (!part_indexes_copy(&part->indexes, &stored_part->indexes))
+      return false;
+    memcpy(stored_part->data, part->data, part->data_len);
+  } else if (!decoder_part_copy(part, stored_part)) {
     return false;
   }
 
@@ -696,6 +1194,29 @@ static bool reduce_part_by_part(const decoder_part_t *const a,
   return true;
 }
 
+// The sink-mode counterpart of reducing a part by every simple part: XOR
+// out each solved fragment it covers, read back from the sink, and drop
+// those indexes in place. Like reduce_part_by_part, stops at one index.
+static void reduce_by_sink(fountain_decoder_t *const decoder,
+                           decoder_part_t *const part) {
+  part_indexes_t *indexes = &part->indexes;
+  size_t kept = 0;
+  for (size_t k = 0; k < indexes->count; k++) {
+    ur_index_t index = indexes->indexes[k];
+    const uint8_t *solved = NULL;
+    if (indexes->count - (k - kept) > 1 &&
+        part_indexes_contains(&decoder->received_part_indexes, index))
+      solved = solved_fragment_data(decoder, index);
+    if (solved) {
+      ur_xor_inplace(part->data, solved, part->data_len);
+      decoder->work_bytes += part->data_len;
+    } else {
+      indexes->indexes[kept++] = index;
+    }
+  }
+  indexes->count = kept;
+}
+
 static bool add_mixed_part(fountain_decoder_t *const decoder,
                            const decoder_part_t *const part,
                            const mixed_part_source_t source) {
@@ -709,9 +1230,10 @@ static bool add_mixed_part(fountain_decoder_t *const decoder,
   }
 
   // Try to add to hash table (which automatically checks for duplicates)
-  if (!mixed_hash_put(decoder->mixed_parts_hash, &part->indexes, part)) {
+  if (!mixed_hash_put(decoder->mixed_parts_hash, &part->indexes, part->data)) {
     return false; // Duplicate or error
   }
+  mixed_scores_update(decoder, &part->indexes, 1);
 
 #ifdef DEBUG_STATS
   // Track the source of this mixed part
@@ -737,132 +1259,180 @@ static bool add_mixed_part(fountain_decoder_t *const decoder,
   return true;
 }
 
-static void fountain_decoder_clear_initialization(fountain_decoder_t *decoder) {
-  if (!decoder)
-    return;
-
-  if (decoder->expected_part_indexes) {
-    part_indexes_free(decoder->expected_part_indexes);
-    decoder->expected_part_indexes = NULL;
-  }
+// Build the mixed-part machinery (table, weighted-progress scores, degree
+// sampler) on the first part with seq_num > seq_len. A scan that only ever
+// sees pure fragments allocates none of it. After fountain_decoder_reset()
+// the (empty) table is reused, and the scores and sampler too when seq_len
+// is unchanged.
+static bool init_mixed_parts(fountain_decoder_t *decoder) {
+  size_t seq_len = decoder->expected_part_count;
   if (decoder->mixed_parts_hash) {
-    mixed_hash_free(decoder->mixed_parts_hash);
-    safe_free(decoder->mixed_parts_hash);
+    mixed_hash_set_block_len(decoder->mixed_parts_hash,
+                             decoder->expected_fragment_len);
+  } else {
+    mixed_parts_hash_t *hash = safe_malloc(sizeof(mixed_parts_hash_t));
+    if (!hash)
+      return false;
+    mixed_hash_init(hash, decoder->expected_fragment_len);
+    decoder->mixed_parts_hash = hash;
   }
-  hash_set_free(&decoder->received_fragments_hashes);
-  random_sampler_free(&decoder->degree_sampler);
 
-  decoder->expected_fragment_len = 0;
-  decoder->expected_message_len = 0;
-  decoder->expected_checksum = 0;
+  // The scores array is always sized for the sampler's seq_len
+  if (decoder->mixed_scores && decoder->degree_sampler.count == seq_len)
+    return true;
+  safe_free(decoder->mixed_scores);
+  degree_sampler_free(&decoder->degree_sampler);
+
+  uint32_t *scores = safe_malloc(seq_len * sizeof(uint32_t));
+  if (!scores || !degree_sampler_init(&decoder->degree_sampler, seq_len)) {
+    free(scores);
+    return false;
+  }
+
+  decoder->mixed_scores = scores;
+  return true;
 }
 
-static void reduce_mixed_by(fountain_decoder_t *const decoder,
-                            const decoder_part_t *const part) {
-  if (!decoder || !part || !decoder->mixed_parts_hash ||
-      decoder->mixed_parts_hash->count == 0)
-    return;
+#ifdef UR_FOUNTAIN_DEFERRED_XOR
+// Deferred XOR: reducing a mixed part by a solved fragment only moves the
+// index from its key to a pending list. The payload is brought up to date
+// once, when the part reaches degree 1 or is XOR'd into another part, so
+// parts that are discarded or reduced again never pay for the XORs.
+
+// XOR the solved fragments in pending into data and empty the list
+static void materialize_pending(fountain_decoder_t *const decoder,
+                                uint8_t *data, size_t data_len,
+                                part_indexes_t *pending) {
+  for (size_t k = 0; k < pending->count; k++) {
+    const uint8_t *solved = solved_fragment_data(decoder, pending->indexes[k]);
+    if (solved) {
+      ur_xor_inplace(data, solved, data_len);
+      decoder->work_bytes += data_len;
+    }
+  }
+  part_indexes_clear(pending);
+}
 
+static void materialize_entry(fountain_decoder_t *const decoder,
+                              size_t entry) {
   mixed_parts_hash_t *hash = decoder->mixed_parts_hash;
+  materialize_pending(decoder, mixed_hash_block(hash, entry), hash->block_len,
+                      &hash->pending[entry]);
+}
 
-  // Entries that reduce to a new bucket are unlinked and threaded onto
-  // rehash_list via entry->next, then reinserted after the walk. This
-  // avoids the per-call malloc for a temp pointer array.
-  hash_entry_t *rehash_list = NULL;
-
-  for (size_t i = 0; i < hash->capacity; i++) {
-    hash_entry_t *entry = hash->buckets[i];
-    hash_entry_t *prev = NULL;
+// Move the solved indexes of a part's key to pending. Returns false on
+// allocation failure, leaving the key unchanged and pending empty.
+static bool defer_solved_indexes(const fountain_decoder_t *decoder,
+                                 part_indexes_t *indexes,
+                                 part_indexes_t *pending) {
+  part_indexes_t unsolved = {0};
+  for (size_t k = 0; k < indexes->count; k++) {
+    ur_index_t index = indexes->indexes[k];
+    bool added =
+        part_indexes_contains(&decoder->received_part_indexes, index)
+            ? part_indexes_add(pending, index)
+            : part_indexes_add(&unsolved, index);
+    if (!added) {
+      free(unsolved.indexes);
+      safe_free(pending->indexes);
+      *pending = (part_indexes_t){0};
+      return false;
+    }
+  }
 
-    while (entry) {
-      hash_entry_t *next = entry->next;
+  free(indexes->indexes);
+  *indexes = unsolved;
+  return true;
+}
 
-      if (!part_indexes_is_strict_subset(&part->indexes, &entry->key)) {
-        prev = entry;
-        entry = next;
-        continue;
-      }
+// Whether any mixed entry's key is a strict superset of indexes
+static bool mixed_has_superset(const mixed_parts_hash_t *hash,
+                               const part_indexes_t *indexes) {
+  for (size_t i = 0; i < hash->count; i++) {
+    if (part_indexes_is_strict_subset(indexes, &hash->keys[i]))
+      return true;
+  }
+  return false;
+}
+#endif // UR_FOUNTAIN_DEFERRED_XOR
 
-      part_indexes_t new_indexes = {0};
-      if (!part_indexes_difference(&entry->key, &part->indexes, &new_indexes)) {
-        prev = entry;
-        entry = next;
-        continue;
-      }
+// Reduce mixed entry i by part (whose indexes must be a strict subset of
+// the entry's): XOR the payload in place and rekey it. Returns false if the
+// entry left the table, having become simple (it is queued) or a duplicate,
+// in which case the caller must look at entry i again.
+static bool reduce_mixed_entry(fountain_decoder_t *const decoder, size_t i,
+                               const decoder_part_t *const part) {
+  mixed_parts_hash_t *hash = decoder->mixed_parts_hash;
 
-      // XOR the data in-place.
-      size_t xor_len = entry->value.data_len < part->data_len
-                           ? entry->value.data_len
-                           : part->data_len;
-      ur_xor_inplace(entry->value.data, part->data, xor_len);
+  part_indexes_t new_indexes = {0};
+  if (!part_indexes_difference(&hash->keys[i], &part->indexes, &new_indexes))
+    return true;
 
-      free(entry->key.indexes);
-      entry->key = new_indexes;
-      entry->key_hash = hash_indexes(&entry->key);
+  uint8_t *block = mixed_hash_block(hash, i);
+  bool deferred = false;
+#ifdef UR_FOUNTAIN_DEFERRED_XOR
+  // Only a fragment that stays stored as a simple part can be deferred
+  deferred = new_indexes.count > 1 && is_simple_part(part) &&
+             part_indexes_contains(&decoder->received_part_indexes,
+                                   get_part_index(part)) &&
+             part_indexes_add(&hash->pending[i], get_part_index(part));
+#endif
+  if (!deferred) {
+    size_t xor_len =
+        hash->block_len < part->data_len ? hash->block_len : part->data_len;
+    ur_xor_inplace(block, part->data, xor_len);
+    decoder->work_bytes += xor_len;
+  }
 
-      free(entry->value.indexes.indexes);
-      entry->value.indexes = (part_indexes_t){0};
-      part_indexes_copy(&new_indexes, &entry->value.indexes);
+  mixed_scores_update(decoder, &hash->keys[i], -1);
 
-      if (is_simple_part(&entry->value)) {
+  if (new_indexes.count == 1) {
 #ifdef DEBUG_STATS
-        decoder->mixed_parts_useful++;
+    decoder->mixed_parts_useful++;
 #endif
-        size_t fragment_idx = get_part_index(&entry->value);
-        if (!part_indexes_contains(&decoder->received_part_indexes,
-                                   fragment_idx)) {
-          queue_enqueue(&decoder->queue, &entry->value);
-        }
-
-        // Unlink from this bucket and free.
-        if (prev) {
-          prev->next = next;
-        } else {
-          hash->buckets[i] = next;
-        }
-        decoder_part_free(&entry->value);
-        free(entry->key.indexes);
-        free(entry);
-        hash->count--;
-        entry = next;
-        continue;
-      }
-
-      size_t new_bucket = entry->key_hash % hash->capacity;
-      if (new_bucket != i) {
-        // Unlink and stash for reinsertion below.
-        if (prev) {
-          prev->next = next;
-        } else {
-          hash->buckets[i] = next;
-        }
-        entry->next = rehash_list;
-        rehash_list = entry;
-        entry = next;
-        continue;
+    if (!part_indexes_contains(&decoder->received_part_indexes,
+                               new_indexes.indexes[0])) {
+#ifdef UR_FOUNTAIN_DEFERRED_XOR
+      materialize_entry(decoder, i);
+#endif
+      decoder_part_t simple = {.indexes = new_indexes};
+      simple.data = safe_malloc_uninit(hash->block_len);
+      if (simple.data) {
+        memcpy(simple.data, block, hash->block_len);
+        simple.data_len = (ur_len_t)hash->block_len;
+        queue_enqueue(&decoder->queue, &simple);
       }
-
-      prev = entry;
-      entry = next;
+      decoder_part_free(&simple);
+    } else {
+      free(new_indexes.indexes);
     }
+    mixed_hash_remove(hash, i);
+    return false;
   }
 
-  // Reinsert stashed entries at the head of their new bucket. A revisit
-  // during this call isn't possible — the outer bucket walk has already
-  // finished by the time we get here.
-  while (rehash_list) {
-    hash_entry_t *e = rehash_list;
-    rehash_list = rehash_list->next;
-    size_t b = e->key_hash % hash->capacity;
-    e->next = hash->buckets[b];
-    hash->buckets[b] = e;
-  }
+  if (!mixed_hash_rekey(hash, i, &new_indexes))
+    return false;
+  mixed_scores_update(decoder, &hash->keys[i], 1);
+  return true;
+}
 
-#ifdef DEBUG_STATS
-  if (hash->count > decoder->maximum_mixed_parts) {
-    decoder->maximum_mixed_parts = hash->count;
+static void reduce_mixed_by(fountain_decoder_t *const decoder,
+                            const decoder_part_t *const part) {
+  if (!decoder || !part || !decoder->mixed_parts_hash ||
+      decoder->mixed_parts_hash->count == 0)
+    return;
+
+  mixed_parts_hash_t *hash = decoder->mixed_parts_hash;
+
+  // A linear walk over the dense key array; payloads are only touched for
+  // the entries that reduce.
+  size_t i = 0;
+  while (i < hash->count) {
+    if (!part_indexes_is_strict_subset(&part->indexes, &hash->keys[i]) ||
+        reduce_mixed_entry(decoder, i, part)) {
+      i++;
+    }
   }
-#endif
 }
 
 #ifdef ENABLE_CROSS_REDUCTION
@@ -907,6 +1477,7 @@ static void reduce_mixed_against_mixed(fountain_decoder_t *const decoder) {
     return;
   }
 
+  mixed_parts_hash_t *hash = decoder->mixed_parts_hash;
   bool made_progress = true;
   int iteration = 0;
 
@@ -914,76 +1485,54 @@ static void reduce_mixed_against_mixed(fountain_decoder_t *const decoder) {
     made_progress = false;
     iteration++;
 
-    // Collect all current hash entries into an array for iteration
-    size_t entry_count = decoder->mixed_parts_hash->count;
-    hash_entry_t **entries = safe_malloc(sizeof(hash_entry_t *) * entry_count);
-    if (!entries)
-      return;
-
-    size_t idx = 0;
-    for (size_t b = 0;
-         b < decoder->mixed_parts_hash->capacity && idx < entry_count; b++) {
-      hash_entry_t *entry = decoder->mixed_parts_hash->buckets[b];
-      while (entry && idx < entry_count) {
-        entries[idx++] = entry;
-        entry = entry->next;
-      }
-    }
-
-    for (size_t i = 0; i < entry_count && !made_progress; i++) {
-      for (size_t offset = 1;
-           offset <= entry_count && (i + offset) < entry_count; offset++) {
-        size_t j = i + offset;
-
-        if (part_indexes_have_intersection(&entries[i]->key,
-                                           &entries[j]->key)) {
+    // The table only changes once made_progress is set, which ends both
+    // loops, so entry numbers stay valid throughout the pass.
+    for (size_t i = 0; i < hash->count && !made_progress; i++) {
+      for (size_t j = i + 1; j < hash->count; j++) {
+        if (!part_indexes_have_intersection(&hash->keys[i], &hash->keys[j]))
+          continue;
 
-          decoder_part_t new_part = {0};
+#ifdef UR_FOUNTAIN_DEFERRED_XOR
+        materialize_entry(decoder, i);
+        materialize_entry(decoder, j);
+#endif
+        decoder_part_t a = mixed_hash_part(hash, i);
+        decoder_part_t b = mixed_hash_part(hash, j);
+        decoder_part_t new_part = {0};
 
-          if (create_symmetric_diff(&entries[i]->value, &entries[j]->value,
-                                    &new_part)) {
+        if (create_symmetric_diff(&a, &b, &new_part)) {
+          decoder->work_bytes += new_part.data_len;
 
-            bool is_simpler = new_part.indexes.count < entries[i]->key.count ||
-                              new_part.indexes.count < entries[j]->key.count;
+          bool is_simpler = new_part.indexes.count < a.indexes.count ||
+                            new_part.indexes.count < b.indexes.count;
 
-            if (!is_simpler) {
-              decoder_part_free(&new_part);
-              continue;
-            }
+          if (!is_simpler) {
+            decoder_part_free(&new_part);
+            continue;
+          }
 
-            // Hash table automatically checks for duplicates in add_mixed_part
-            if (new_part.indexes.count > 0) {
-              if (is_simple_part(&new_part)) {
+          // Hash table automatically checks for duplicates in add_mixed_part
+          if (is_simple_part(&new_part)) {
 #ifdef DEBUG_STATS
-                decoder->mixed_parts_useful++; // Cross-reduction led to simple
-                                               // part!
+            decoder->mixed_parts_useful++; // Cross-reduction led to simple
+                                           // part!
 #endif
-                size_t fragment_idx = get_part_index(&new_part);
-                if (!part_indexes_contains(&decoder->received_part_indexes,
-                                           fragment_idx)) {
-                  queue_enqueue(&decoder->queue, &new_part);
-                  made_progress = true;
-                }
-                decoder_part_free(&new_part);
-                break;
-              } else {
-                if (add_mixed_part(decoder, &new_part,
-                                   MIXED_SOURCE_CROSS_REDUCTION)) {
-                  made_progress = true;
-                  gaussian_reduce_with_new_part(decoder, &new_part);
-                }
-                decoder_part_free(&new_part);
-              }
-              break;
-            } else {
-              decoder_part_free(&new_part);
+            ur_index_t fragment_idx = get_part_index(&new_part);
+            if (!part_indexes_contains(&decoder->received_part_indexes,
+                                       fragment_idx)) {
+              queue_enqueue(&decoder->queue, &new_part);
+              made_progress = true;
             }
+          } else if (add_mixed_part(decoder, &new_part,
+                                    MIXED_SOURCE_CROSS_REDUCTION)) {
+            made_progress = true;
+            gaussian_reduce_with_new_part(decoder, &new_part);
           }
+          decoder_part_free(&new_part);
+          break;
         }
       }
     }
-
-    free(entries);
   }
 }
 
@@ -992,77 +1541,84 @@ static void gaussian_reduce_with_new_part(fountain_decoder_t *const decoder,
   if (!decoder || !pivot || is_simple_part(pivot) || !decoder->mixed_parts_hash)
     return;
 
-  // We iterate over buckets directly to avoid stale pointer issues.
-  // When we remove an entry and add a new one, we need to be careful:
-  // - The new entry goes to the HEAD of its bucket
-  // - We only continue with 'next' which was valid before the modification
-  for (size_t b = 0; b < decoder->mixed_parts_hash->capacity; b++) {
-    hash_entry_t *entry = decoder->mixed_parts_hash->buckets[b];
-    hash_entry_t *prev = NULL;
-
-    while (entry) {
-      // Save next pointer BEFORE any potential modification
-      hash_entry_t *next = entry->next;
-
-      // Skip if this is the pivot itself
-      if (part_indexes_equal(&entry->key, &pivot->indexes)) {
-        prev = entry;
-        entry = next;
-        continue;
-      }
-
-      if (part_indexes_is_strict_subset(&pivot->indexes, &entry->key)) {
-        decoder_part_t reduced = {0};
-
-        if (reduce_part_by_part(&entry->value, pivot, &reduced)) {
-          // Unlink entry from bucket chain BEFORE freeing
-          if (prev) {
-            prev->next = next;
-          } else {
-            decoder->mixed_parts_hash->buckets[b] = next;
-          }
-
-          // Free the entry
-          decoder_part_free(&entry->value);
-          if (entry->key.indexes) {
-            free(entry->key.indexes);
-          }
-          free(entry);
-          decoder->mixed_parts_hash->count--;
+  // The pivot's own entry is never a strict superset of it, so it is
+  // skipped by the subset test.
+  mixed_parts_hash_t *hash = decoder->mixed_parts_hash;
+  size_t i = 0;
+  while (i < hash->count) {
+    if (!part_indexes_is_strict_subset(&pivot->indexes, &hash->keys[i])) {
+      i++;
+      continue;
+    }
+    if (reduce_mixed_entry(decoder, i, pivot)) {
+#ifdef DEBUG_STATS
+      decoder->mixed_from_reduction++;
+#endif
+      i++;
+    }
+  }
+}
+#endif // ENABLE_CROSS_REDUCTION
 
-          // Handle reduced part
-          if (is_simple_part(&reduced)) {
-            size_t fragment_idx = get_part_index(&reduced);
-            if (!part_indexes_contains(&decoder->received_part_indexes,
-                                       fragment_idx)) {
-              queue_enqueue(&decoder->queue, &reduced);
-            }
-          } else {
-            // Add reduced mixed part back
-            add_mixed_part(decoder, &reduced, MIXED_SOURCE_REDUCTION);
-          }
-          decoder_part_free(&reduced);
+// Hand each fragment that extends the contiguous solved prefix to the
+// prefix callback. received_part_indexes is sorted, so the prefix is the
+// leading run with indexes[i] == i.
+static void deliver_prefix(fountain_decoder_t *const decoder) {
+  if (!decoder->prefix_fn)
+    return;
 
-          // Don't update prev - it still points to the previous valid entry
-          // (or is NULL if we removed the head)
-          entry = next;
-          continue;
-        }
-      }
+  const part_indexes_t *received = &decoder->received_part_indexes;
+  while (decoder->prefix_fragments < received->count &&
+         received->indexes[decoder->prefix_fragments] ==
+             decoder->prefix_fragments) {
+    size_t offset;
+    size_t len = fragment_span(decoder, decoder->prefix_fragments, &offset);
+    const uint8_t *data = solved_fragment_data(
+        decoder, (ur_index_t)decoder->prefix_fragments);
+    if (!data)
+      return; // a failed sink read, which ended the decode
+    decoder->prefix_fragments++;
+    if (len > 0) {
+      decoder->prefix_fn(decoder->prefix_ctx, offset, data, len);
+    }
+  }
+}
 
-      prev = entry;
-      entry = next;
+// Sink-mode completion: every fragment is already in place, so the checksum
+// is computed over the message read back one fragment at a time
+static void complete_in_sink(fountain_decoder_t *const decoder) {
+  size_t message_len = decoder->expected_message_len;
+  size_t fragment_len = decoder->expected_fragment_len;
+  uint32_t crc = 0;
+  bool read_ok = fragment_len > 0;
+  for (size_t offset = 0; read_ok && offset < message_len;
+       offset += fragment_len) {
+    size_t len = message_len - offset < fragment_len ? message_len - offset
+                                                     : fragment_len;
+    read_ok = decoder->sink.read(decoder->sink.ctx, offset, decoder->sink_buf,
+                                 len);
+    if (read_ok) {
+      crc = crc32_update(crc, decoder->sink_buf, len);
     }
   }
+  decoder->work_bytes += message_len;
+
+  decoder->result = safe_malloc(sizeof(fountain_decoder_result_t));
+  if (decoder->result) {
+    bool ok = read_ok && crc == decoder->expected_checksum;
+    decoder->result->data = NULL;
+    decoder->result->data_len = ok ? message_len : 0;
+    decoder->result->is_success = ok;
+    decoder->result->is_error = !ok;
+  }
 }
-#endif // ENABLE_CROSS_REDUCTION
 
 static void process_simple_part(fountain_decoder_t *const decoder,
                                 const decoder_part_t *const part) {
-  if (!decoder || !part || !is_simple_part(part))
+  if (!decoder || !part || !is_simple_part(part) || decoder->result)
     return;
 
-  size_t fragment_index = get_part_index(part);
+  ur_index_t fragment_index = get_part_index(part);
 
   if (part_indexes_contains(&decoder->received_part_indexes, fragment_index)) {
     return;
@@ -1076,9 +1632,15 @@ static void process_simple_part(fountain_decoder_t *const decoder,
     return;
   }
 
-  if (decoder->expected_part_indexes &&
-      part_indexes_equal(&decoder->received_part_indexes,
-                         decoder->expected_part_indexes)) {
+  deliver_prefix(decoder);
+
+  // Every index is below expected_part_count, so a full count means every
+  // fragment is solved
+  if (decoder->received_part_indexes.count == decoder->expected_part_count) {
+    if (has_sink(decoder)) {
+      complete_in_sink(decoder);
+      return;
+    }
 
     size_t part_count = decoder->simple_parts.count;
 
@@ -1087,9 +1649,9 @@ static void process_simple_part(fountain_decoder_t *const decoder,
     // which is small in practice, so O(n²) is fine and saves the three
     // temporary arrays the earlier qsort-based path allocated.
     for (size_t i = 1; i < part_count; i++) {
-      size_t key = decoder->simple_parts.keys[i];
+      ur_index_t key = decoder->simple_parts.keys[i];
       decoder_part_t val = decoder->simple_parts.values[i];
-      size_t val_len = decoder->simple_parts.value_lens[i];
+      ur_len_t val_len = decoder->simple_parts.value_lens[i];
       size_t j = i;
       while (j > 0 && decoder->simple_parts.keys[j - 1] > key) {
         decoder->simple_parts.keys[j] = decoder->simple_parts.keys[j - 1];
@@ -1126,6 +1688,7 @@ static void process_simple_part(fountain_decoder_t *const decoder,
 
       uint32_t checksum =
           crc32_calculate(message, decoder->expected_message_len);
+      decoder->work_bytes += decoder->expected_message_len;
 
       if (checksum == decoder->expected_checksum) {
         decoder->result = safe_malloc(sizeof(fountain_decoder_result_t));
@@ -1177,36 +1740,73 @@ static void process_mixed_part(fountain_decoder_t *const decoder,
     return;
   }
 
-  for (size_t i = 0; i < decoder->simple_parts.count; i++) {
+  part_indexes_t pending = {0};
+  bool deferred = false;
+#ifdef UR_FOUNTAIN_DEFERRED_XOR
+  deferred = defer_solved_indexes(decoder, &reduced_part.indexes, &pending);
+  if (deferred && reduced_part.indexes.count == 0) {
+    // Every fragment it covers is already solved
+    decoder_part_free(&reduced_part);
+    free(pending.indexes);
+    return;
+  }
+#endif
+
+  if (!deferred && has_sink(decoder)) {
+    reduce_by_sink(decoder, &reduced_part);
+  }
+  for (size_t i = 0; !deferred && i < decoder->simple_parts.count; i++) {
     decoder_part_t temp = {0};
 
     if (reduce_part_by_part(&reduced_part, &decoder->simple_parts.values[i],
                             &temp)) {
       decoder_part_free(&reduced_part);
       reduced_part = temp;
+      decoder->work_bytes += reduced_part.data_len;
     }
   }
 
-  for (size_t i = 0; i < decoder->mixed_parts_hash->capacity; i++) {
-    hash_entry_t *entry = decoder->mixed_parts_hash->buckets[i];
-    while (entry) {
-      decoder_part_t temp = {0};
+  mixed_parts_hash_t *hash = decoder->mixed_parts_hash;
+  for (size_t i = 0; i < hash->count; i++) {
+#ifdef UR_FOUNTAIN_DEFERRED_XOR
+    if (!part_indexes_is_strict_subset(&hash->keys[i], &reduced_part.indexes))
+      continue;
+    materialize_entry(decoder, i);
+#endif
+    decoder_part_t temp = {0};
+    decoder_part_t entry = mixed_hash_part(hash, i);
 
-      if (reduce_part_by_part(&reduced_part, &entry->value, &temp)) {
-        decoder_part_free(&reduced_part);
-        reduced_part = temp;
-      }
-      entry = entry->next;
+    if (reduce_part_by_part(&reduced_part, &entry, &temp)) {
+      decoder_part_free(&reduced_part);
+      reduced_part = temp;
+      decoder->work_bytes += reduced_part.data_len;
     }
   }
 
   if (is_simple_part(&reduced_part)) {
+#ifdef UR_FOUNTAIN_DEFERRED_XOR
+    materialize_pending(decoder, reduced_part.data, reduced_part.data_len,
+                        &pending);
+#endif
     queue_enqueue(&decoder->queue, &reduced_part);
   } else {
+#ifdef UR_FOUNTAIN_DEFERRED_XOR
+    // Reducing other entries by this part XORs its payload into theirs
+    if (pending.count > 0 && mixed_has_superset(hash, &reduced_part.indexes))
+      materialize_pending(decoder, reduced_part.data, reduced_part.data_len,
+                          &pending);
+#endif
     reduce_mixed_by(decoder, &reduced_part);
-    add_mixed_part(decoder, &reduced_part, MIXED_SOURCE_FRAGMENT);
+    if (add_mixed_part(decoder, &reduced_part, MIXED_SOURCE_FRAGMENT)) {
+#ifdef UR_FOUNTAIN_DEFERRED_XOR
+      // add_mixed_part appends, so the new entry is the last one
+      hash->pending[hash->count - 1] = pending;
+      pending = (part_indexes_t){0};
+#endif
+    }
   }
 
+  free(pending.indexes);
   decoder_part_free(&reduced_part);
 }
 
@@ -1229,7 +1829,7 @@ static void process_queue_item(fountain_decoder_t *const decoder) {
   decoder_part_free(&part);
 }
 
-bool fountain_decoder_receive_part(fountain_decoder_t *decoder,
+bool fountain_decoder_enqueue_part(fountain_decoder_t *decoder,
                                    fountain_encoder_part_t *part) {
   if (!decoder || !part) {
     return false;
@@ -1244,71 +1844,51 @@ bool fountain_decoder_receive_part(fountain_decoder_t *decoder,
     return true;
   }
 
-  if (decoder->expected_part_indexes == NULL) {
-    decoder->expected_part_indexes = part_indexes_new();
-    if (!decoder->expected_part_indexes)
+  if (decoder->expected_part_count == 0) {
+    // Fragment indexes and payload lengths are stored compactly
+    if (part->seq_len == 0 || part->seq_len > UR_INDEX_MAX ||
+        part->data_len > UR_LEN_MAX)
+      return false;
+
+    // Every fragment is ceil(message_len / seq_len) bytes; a first part
+    // that disagrees would have later fragments written or joined outside
+    // the message
+    if (part->data_len == 0 ||
+        part->message_len / part->seq_len +
+                (part->message_len % part->seq_len != 0) !=
+            part->data_len)
       return false;
 
-    for (size_t i = 0; i < part->seq_len; i++) {
-      if (!part_indexes_add(decoder->expected_part_indexes, i)) {
-        fountain_decoder_clear_initialization(decoder);
+    // The sink learns the message length; its read-back buffer is one
+    // fragment
+    if (has_sink(decoder)) {
+      safe_free(decoder->sink_buf);
+      decoder->sink_buf = safe_malloc_uninit(part->data_len);
+      if ((!decoder->sink_buf && part->data_len > 0) ||
+          (decoder->sink.begin &&
+           !decoder->sink.begin(decoder->sink.ctx, part->message_len)))
         return false;
-      }
     }
 
+    decoder->expected_part_count = part->seq_len;
     decoder->expected_checksum = part->checksum;
     decoder->expected_fragment_len = part->data_len;
     decoder->expected_message_len = part->message_len;
+  }
 
-    size_t hash_capacity =
-        part->seq_len < (HASH_MIN_CAPACITY / HASH_CAPACITY_MULTIPLIER)
-            ? HASH_MIN_CAPACITY
-            : part->seq_len * HASH_CAPACITY_MULTIPLIER;
-
-    decoder->mixed_parts_hash = safe_malloc(sizeof(mixed_parts_hash_t));
-    if (!decoder->mixed_parts_hash) {
-      fountain_decoder_clear_initialization(decoder);
-      return false;
-    }
-
-    if (!mixed_hash_init(decoder->mixed_parts_hash, hash_capacity)) {
-      fountain_decoder_clear_initialization(decoder);
-      return false;
-    }
-
-    if (!hash_set_init(&decoder->received_fragments_hashes, hash_capacity)) {
-      fountain_decoder_clear_initialization(decoder);
-      return false;
-    }
-
-    // Degree probs and the sampler stay double — interop-critical, must
-    // match reference implementations bit-for-bit (see fountain_utils.c).
-    if (part->seq_len > 0) {
-      double *degree_probs = safe_malloc(part->seq_len * sizeof(double));
-      if (!degree_probs) {
-        fountain_decoder_clear_initialization(decoder);
-        return false;
-      }
-      for (size_t i = 0; i < part->seq_len; i++) {
-        degree_probs[i] = 1.0 / (i + 1);
-      }
-      if (!random_sampler_init(&decoder->degree_sampler, degree_probs,
-                               part->seq_len)) {
-        free(degree_probs);
-        fountain_decoder_clear_initialization(decoder);
-        return false;
-      }
-      free(degree_probs);
-    }
+  // Every part of a message carries the same seq_len and the same padded
+  // fragment length (ceil(message_len / seq_len), last fragment zero-padded
+  // by the encoder). A part that disagrees is malformed: a foreign seq_len
+  // would yield indexes outside the message, and a foreign length would let
+  // the XOR reduction (reduce_part_by_part / create_symmetric_diff /
+  // reduce_mixed_by) read past a shorter part's buffer. The first part sets
+  // both above, so it always passes this check.
+  if (part->seq_len != decoder->expected_part_count ||
+      part->data_len != decoder->expected_fragment_len) {
+    return false;
   }
 
-  // Every part of a message carries the same padded fragment length
-  // (ceil(message_len / seq_len), last fragment zero-padded by the encoder).
-  // A part whose length disagrees is malformed; accepting it would let the XOR
-  // reduction (reduce_part_by_part / create_symmetric_diff / reduce_mixed_by)
-  // read past a shorter part's buffer. The first part sets the expected length
-  // above, so it always passes this check.
-  if (part->data_len != decoder->expected_fragment_len) {
+  if (part->seq_num > part->seq_len && !init_mixed_parts(decoder)) {
     return false;
   }
 
@@ -1326,10 +1906,9 @@ bool fountain_decoder_receive_part(fountain_decoder_t *decoder,
 
   hash_set_add(&decoder->received_fragments_hashes, fragment_hash);
 
-  if (decoder->last_part_indexes) {
-    part_indexes_free(decoder->last_part_indexes);
+  if (!decoder->last_part_indexes) {
+    decoder->last_part_indexes = part_indexes_new();
   }
-  decoder->last_part_indexes = part_indexes_new();
   if (decoder->last_part_indexes) {
     part_indexes_copy(&decoder_part.indexes, decoder->last_part_indexes);
   }
@@ -1339,17 +1918,37 @@ bool fountain_decoder_receive_part(fountain_decoder_t *decoder,
     return false;
   }
 
-  while (!fountain_decoder_is_complete(decoder) &&
-         !queue_is_empty(&decoder->queue)) {
-    process_queue_item(decoder);
-  }
-
   decoder->processed_parts_count++;
   decoder->last_fragment_seq_num = part->seq_num;
   decoder->has_received_fragment = true;
 
-  decoder_part_free(&decoder_part);
+  return true;
+}
+
+bool fountain_decoder_step(fountain_decoder_t *decoder, size_t work_budget) {
+  if (!decoder)
+    return false;
+
+  // work_bytes only grows between checks; measure relative to the start so
+  // the counter may wrap without effect.
+  size_t start = decoder->work_bytes;
+  do {
+    if (fountain_decoder_is_complete(decoder) ||
+        queue_is_empty(&decoder->queue))
+      return false;
+    process_queue_item(decoder);
+  } while (decoder->work_bytes - start < work_budget);
+
+  return !fountain_decoder_is_complete(decoder) &&
+         !queue_is_empty(&decoder->queue);
+}
 
+bool fountain_decoder_receive_part(fountain_decoder_t *decoder,
+                                   fountain_encoder_part_t *part) {
+  if (!fountain_decoder_enqueue_part(decoder, part))
+    return false;
+
+  fountain_decoder_step(decoder, SIZE_MAX);
   return true;
 }
 
@@ -1362,9 +1961,9 @@ bool fountain_decoder_is_success(fountain_decoder_t *decoder) {
 }
 
 size_t fountain_decoder_expected_part_count(fountain_decoder_t *decoder) {
-  if (!decoder || !decoder->expected_part_indexes)
+  if (!decoder)
     return 0;
-  return decoder->expected_part_indexes->count;
+  return decoder->expected_part_count;
 }
 
 float fountain_decoder_estimated_percent_complete(fountain_decoder_t *decoder) {
@@ -1372,7 +1971,7 @@ float fountain_decoder_estimated_percent_complete(fountain_decoder_t *decoder) {
     return 0.0f;
   if (fountain_decoder_is_complete(decoder))
     return 1.0f;
-  if (!decoder->expected_part_indexes)
+  if (decoder->expected_part_count == 0)
     return 0.0f;
 
   float estimated_input_parts =
@@ -1400,33 +1999,9 @@ float fountain_decoder_estimated_percent_complete_weighted(
   if (parts == 0)
     return 0.0f;
 
-  float mixed_score = 0.0f;
-  mixed_parts_hash_t *hash = decoder->mixed_parts_hash;
-  if (hash && hash->count > 0) {
-    // Per-index partial scores from the mixed parts. Fragment indexes are in
-    // [0, seq_len) == [0, parts), so a scratch array keyed by index mirrors
-    // the Python dict `mixed_index_scoring`. If the scratch allocation fails,
-    // mixed_score stays 0 — still the weighted metric, just without partial
-    // credit, so the value never jumps to a different scale.
-    float *scoring = safe_malloc(parts * sizeof(float));
-    if (scoring) {
-      for (size_t b = 0; b < hash->capacity; b++) {
-        for (hash_entry_t *entry = hash->buckets[b]; entry;
-             entry = entry->next) {
-          float score = 1.0f / (float)entry->key.count;
-          for (size_t k = 0; k < entry->key.count; k++) {
-            size_t index = entry->key.indexes[k];
-            if (index < parts)
-              scoring[index] += score;
-          }
-        }
-      }
-      for (size_t i = 0; i < parts; i++) {
-        mixed_score += scoring[i] < 0.75f ? scoring[i] : 0.75f;
-      }
-      safe_free(scoring);
-    }
-  }
+  // Partial credit is maintained incrementally (mixed_scores_update), so
+  // this is an O(1), allocation-free read.
+  float mixed_score = (float)decoder->mixed_score_sum / (float)MIXED_SCORE_ONE;
 
   float num_complete = (float)decoder->received_part_indexes.count;
   float progress = (num_complete + mixed_score) / (float)parts;
@@ -1468,3 +2043,40 @@ size_t fountain_decoder_received_parts_count(fountain_decoder_t *decoder) {
     return 0;
   return decoder->received_part_indexes.count;
 }
+
+size_t fountain_decoder_solved_bitmap(fountain_decoder_t *decoder,
+                                      uint8_t *bitmap, size_t bitmap_len) {
+  if (!decoder)
+    return 0;
+
+  size_t parts = fountain_decoder_expected_part_count(decoder);
+  size_t needed = (parts + 7) / 8;
+  if (!bitmap || bitmap_len < needed)
+    return needed;
+
+  memset(bitmap, 0, needed);
+  const part_indexes_t *received = &decoder->received_part_indexes;
+  for (size_t i = 0; i < received->count; i++) {
+    size_t index = received->indexes[i];
+    if (index < parts)
+      bitmap[index / 8] |= (uint8_t)(1u << (index % 8));
+  }
+  return needed;
+}
+
+void fountain_decoder_get_stats(fountain_decoder_t *decoder,
+                                fountain_decoder_stats_t *stats) {
+  if (!stats)
+    return;
+  memset(stats, 0, sizeof(*stats));
+  if (!decoder)
+    return;
+
+  stats->expected_part_count = fountain_decoder_expected_part_count(decoder);
+  stats->received_parts_count = decoder->received_part_indexes.count;
+  stats->processed_parts_count = decoder->processed_parts_count;
+  stats->mixed_parts_count =
+      decoder->mixed_parts_hash ? decoder->mixed_parts_hash->count : 0;
+  stats->message_len = decoder->expected_message_len;
+  stats->fragment_len = decoder->expected_fragment_len;
+}
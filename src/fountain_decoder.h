@@ -4,6 +4,7 @@
 // #define DEBUG_STATS
 
 #include "fountain_types.h"
+#include "ur_export.h"
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
@@ -19,19 +20,90 @@ typedef struct {
   bool is_error;
 } fountain_decoder_result_t;
 
+// Decoder counters, snapshotted by fountain_decoder_get_stats()
+typedef struct {
+  size_t expected_part_count;   // seq_len of the message being decoded
+  size_t received_parts_count;  // unique pure fragments recovered
+  size_t processed_parts_count; // unique frames accepted
+  size_t mixed_parts_count;     // mixed (XOR'd) parts currently retained
+  size_t message_len;           // expected message length in bytes
+  size_t fragment_len;          // expected fragment length in bytes
+} fountain_decoder_stats_t;
+
+// Destination for the reassembled message, for messages too large to hold
+// in RAM. begin(), if set, is called once with the message length when the
+// first part arrives. Each solved fragment is written once to its final
+// offset (the last one trimmed to message_len); read() returns bytes
+// already written, for the reduction of mixed parts and the closing
+// checksum pass. A failed write or read ends the decode with an error
+// result. close(), if set, releases ctx.
+typedef struct {
+  bool (*begin)(void *ctx, size_t message_len);
+  bool (*write)(void *ctx, size_t offset, const uint8_t *buf, size_t len);
+  bool (*read)(void *ctx, size_t offset, uint8_t *buf, size_t len);
+  void (*close)(void *ctx);
+  void *ctx;
+} fountain_sink_t;
+
+// Receives the message in order while it is still being decoded: called
+// each time the contiguous solved prefix grows, with the next len bytes at
+// offset (the previous call's offset + len). data points into decoder
+// storage and is valid only during the call. The bytes are not yet
+// checksum-verified; the final CRC still decides the result.
+typedef void (*fountain_prefix_fn)(void *ctx, size_t offset,
+                                   const uint8_t *data, size_t len);
+
 // Function declarations
 
 /**
  * Create a new fountain decoder
  * @return Pointer to fountain decoder or NULL on error
  */
-fountain_decoder_t *fountain_decoder_new(void);
+UR_API fountain_decoder_t *fountain_decoder_new(void);
 
 /**
  * Free fountain decoder
  * @param decoder Pointer to fountain decoder
  */
-void fountain_decoder_free(fountain_decoder_t *decoder);
+UR_API void fountain_decoder_free(fountain_decoder_t *decoder);
+
+/**
+ * Return the decoder to its freshly created state for the next message,
+ * keeping allocated capacity: the part tables, queue, duplicate filter and
+ * stored fragment buffers, plus the degree sampler when the next message
+ * has the same seq_len. Any result not taken is freed, an output sink is
+ * closed and removed, and the prefix callback is cleared.
+ * @param decoder Pointer to fountain decoder
+ * @param shrink_threshold Free each retained structure holding more than
+ *                         this many bytes (0 = keep everything)
+ */
+UR_API void fountain_decoder_reset(fountain_decoder_t *decoder,
+                                   size_t shrink_threshold);
+
+/**
+ * Send the message to a sink instead of decoder memory. Solved fragments
+ * are written out as they are recovered, so apart from the retained mixed
+ * parts the decoder holds only per-fragment bookkeeping. On success the
+ * result has data NULL and data_len the message length; the message is in
+ * the sink, checksum verified. Must be set before the first part.
+ * @param decoder Pointer to fountain decoder
+ * @param sink Output sink; the decoder owns it from this call on and
+ *             closes it on free or reset, or before returning false
+ * @return true on success; false if a part was already received
+ */
+UR_API bool fountain_decoder_set_sink(fountain_decoder_t *decoder,
+                                      const fountain_sink_t *sink);
+
+/**
+ * Set (or clear, with fn NULL) the in-order prefix callback. Set after
+ * parts have arrived, its first call delivers the prefix solved so far.
+ * @param decoder Pointer to fountain decoder
+ * @param fn Callback, or NULL
+ * @param ctx Passed to fn
+ */
+UR_API void fountain_decoder_set_prefix_callback(fountain_decoder_t *decoder,
+                                                 fountain_prefix_fn fn,
+                                                 void *ctx);
 
 /**
  * Receive a fountain encoder part
@@ -39,36 +111,64 @@ void fountain_decoder_free(fountain_decoder_t *decoder);
  * @param part Pointer to encoder part
  * @return true on success, false on error
  */
-bool fountain_decoder_receive_part(fountain_decoder_t *decoder,
-                                   fountain_encoder_part_t *part);
+UR_API bool fountain_decoder_receive_part(fountain_decoder_t *decoder,
+                                          fountain_encoder_part_t *part);
+
+/**
+ * Validate a fountain encoder part and queue it without running the
+ * reduction cascade; fountain_decoder_step() does the work later.
+ * fountain_decoder_receive_part() is enqueue followed by a full drain.
+ * The first part fixes the message: its fragment length must be
+ * ceil(message_len / seq_len), and every later part must match it.
+ * @param decoder Pointer to fountain decoder
+ * @param part Pointer to encoder part (its data is moved into the queue)
+ * @return true on success (including an ignored duplicate), false on error
+ */
+UR_API bool fountain_decoder_enqueue_part(fountain_decoder_t *decoder,
+                                          fountain_encoder_part_t *part);
+
+/**
+ * Process queued parts until work_budget bytes have been XOR'd or copied.
+ * The budget is checked between queued parts only: each part is processed
+ * whole, including the cascade of mixed parts its fragment solves, which
+ * is not bounded by the budget and near the end of a message can reduce
+ * every retained mixed part. At least one queued part is processed per
+ * call, so any budget makes progress.
+ * @param decoder Pointer to fountain decoder
+ * @param work_budget Work budget in bytes (0 = one queued part)
+ * @return true if queued work remains, false if idle or complete
+ */
+UR_API bool fountain_decoder_step(fountain_decoder_t *decoder,
+                                  size_t work_budget);
 
 /**
  * Check if decoding is complete
  * @param decoder Pointer to fountain decoder
  * @return true if complete, false otherwise
  */
-bool fountain_decoder_is_complete(fountain_decoder_t *decoder);
+UR_API bool fountain_decoder_is_complete(fountain_decoder_t *decoder);
 
 /**
  * Check if decoding was successful
  * @param decoder Pointer to fountain decoder
  * @return true if successful, false otherwise
  */
-bool fountain_decoder_is_success(fountain_decoder_t *decoder);
+UR_API bool fountain_decoder_is_success(fountain_decoder_t *decoder);
 
 /**
  * Get expected part count
  * @param decoder Pointer to fountain decoder
  * @return Expected part count
  */
-size_t fountain_decoder_expected_part_count(fountain_decoder_t *decoder);
+UR_API size_t fountain_decoder_expected_part_count(fountain_decoder_t *decoder);
 
 /**
  * Get processed parts count
  * @param decoder Pointer to fountain decoder
  * @return Number of processed parts
  */
-size_t fountain_decoder_processed_parts_count(fountain_decoder_t *decoder);
+UR_API size_t fountain_decoder_processed_parts_count(
+    fountain_decoder_t *decoder);
 
 /**
  * Get the number of unique pure fragments recovered so far (out of
@@ -78,14 +178,36 @@ size_t fountain_decoder_processed_parts_count(fountain_decoder_t *decoder);
  * @param decoder Pointer to fountain decoder
  * @return Number of unique received fragment indexes
  */
-size_t fountain_decoder_received_parts_count(fountain_decoder_t *decoder);
+UR_API size_t fountain_decoder_received_parts_count(
+    fountain_decoder_t *decoder);
+
+/**
+ * Write the per-fragment solved bitmap: bit (i % 8) of byte (i / 8) is set
+ * once fragment i has been recovered in pure form.
+ * @param decoder Pointer to fountain decoder
+ * @param bitmap Output buffer, or NULL to query the size
+ * @param bitmap_len Size of bitmap; nothing is written if it is too small
+ * @return Bitmap size in bytes, (expected_part_count + 7) / 8
+ */
+UR_API size_t fountain_decoder_solved_bitmap(fountain_decoder_t *decoder,
+                                             uint8_t *bitmap,
+                                             size_t bitmap_len);
+
+/**
+ * Snapshot the decoder counters
+ * @param decoder Pointer to fountain decoder
+ * @param stats Output stats (zeroed when decoder is NULL)
+ */
+UR_API void fountain_decoder_get_stats(fountain_decoder_t *decoder,
+                                       fountain_decoder_stats_t *stats);
 
 /**
  * Get estimated completion percentage
  * @param decoder Pointer to fountain decoder
  * @return Completion percentage (0.0 to 1.0)
  */
-float fountain_decoder_estimated_percent_complete(fountain_decoder_t *decoder);
+UR_API float fountain_decoder_estimated_percent_complete(
+    fountain_decoder_t *decoder);
 
 /**
  * Get estimated completion percentage using the weighted-mixed-frames method
@@ -93,7 +215,7 @@ float fountain_decoder_estimated_percent_complete(fountain_decoder_t *decoder);
  * @param decoder Pointer to fountain decoder
  * @return Completion percentage (0.0 to 1.0)
  */
-float fountain_decoder_estimated_percent_complete_weighted(
+UR_API float fountain_decoder_estimated_percent_complete_weighted(
     fountain_decoder_t *decoder);
 
 /**
@@ -101,14 +223,14 @@ float fountain_decoder_estimated_percent_complete_weighted(
  * @param decoder Pointer to fountain decoder
  * @return Pointer to result data or NULL
  */
-uint8_t *fountain_decoder_result_message(fountain_decoder_t *decoder);
+UR_API uint8_t *fountain_decoder_result_message(fountain_decoder_t *decoder);
 
 /**
  * Get result message length
  * @param decoder Pointer to fountain decoder
  * @return Result data length
  */
-size_t fountain_decoder_result_message_len(fountain_decoder_t *decoder);
+UR_API size_t fountain_decoder_result_message_len(fountain_decoder_t *decoder);
 
 /**
  * Transfer ownership of the result message to the caller. The decoder
@@ -118,6 +240,7 @@ size_t fountain_decoder_result_message_len(fountain_decoder_t *decoder);
  * @param decoder Pointer to fountain decoder
  * @return Heap pointer the caller must free, or NULL
  */
-uint8_t *fountain_decoder_take_result_message(fountain_decoder_t *decoder);
+UR_API uint8_t *fountain_decoder_take_result_message(
+    fountain_decoder_t *decoder);
 
 #endif // FOUNTAIN_DECODER_H
@@ -214,11 +214,11 @@ static bool cbor_lite_encode_bytes(cbor_lite_encoder_t *enc,
 // Fragment array operations
 
 bool fragment_array_init(fragment_array_t *arr, size_t capacity) {
-  if (!arr || capacity == 0)
+  if (!arr || capacity == 0 || capacity > UR_INDEX_MAX)
     return false;
 
   arr->fragments = (uint8_t **)calloc(capacity, sizeof(uint8_t *));
-  arr->fragment_lens = (size_t *)calloc(capacity, sizeof(size_t));
+  arr->fragment_lens = (ur_len_t *)calloc(capacity, sizeof(ur_len_t));
   if (!arr->fragments || !arr->fragment_lens) {
     free(arr->fragments);
     free(arr->fragment_lens);
@@ -226,7 +226,7 @@ bool fragment_array_init(fragment_array_t *arr, size_t capacity) {
   }
 
   arr->count = 0;
-  arr->capacity = capacity;
+  arr->capacity = (ur_index_t)capacity;
   return true;
 }
 
@@ -248,7 +248,7 @@ void fragment_array_free(fragment_array_t *arr) {
 
 bool fragment_array_add(fragment_array_t *arr, const uint8_t *data,
                         size_t len) {
-  if (!arr || !data || arr->count >= arr->capacity)
+  if (!arr || !data || arr->count >= arr->capacity || len > UR_LEN_MAX)
     return false;
 
   // Through the platform allocator: PSRAM routing and, with the P4 SIMD
@@ -258,7 +258,7 @@ bool fragment_array_add(fragment_array_t *arr, const uint8_t *data,
     return false;
 
   memcpy(arr->fragments[arr->count], data, len);
-  arr->fragment_lens[arr->count] = len;
+  arr->fragment_lens[arr->count] = (ur_len_t)len;
   arr->count++;
   return true;
 }
@@ -291,7 +291,8 @@ size_t fountain_encoder_find_nominal_fragment_length(size_t message_len,
 bool fountain_encoder_partition_message(const uint8_t *message,
                                         size_t message_len, size_t fragment_len,
                                         fragment_array_t *fragments) {
-  if (!message || !fragments || message_len == 0 || fragment_len == 0) {
+  if (!message || !fragments || message_len == 0 || fragment_len == 0 ||
+      fragment_len > UR_LEN_MAX) {
     return false;
   }
 
@@ -322,7 +323,7 @@ bool fountain_encoder_partition_message(const uint8_t *message,
     }
 
     fragments->fragments[fragments->count] = fragment;
-    fragments->fragment_lens[fragments->count] = fragment_len;
+    fragments->fragment_lens[fragments->count] = (ur_len_t)fragment_len;
     fragments->count++;
     offset += fragment_len;
   }
@@ -330,6 +331,24 @@ bool fountain_encoder_partition_message(const uint8_t *message,
   return true;
 }
 
+// Shared tail of both constructors: everything but the message storage
+static bool encoder_init_sequence(fountain_encoder_t *encoder,
+                                  uint32_t first_seq_num) {
+  encoder->seq_num = first_seq_num;
+
+  // Initialize last_part_indexes (allocate it properly)
+  encoder->last_part_indexes.indexes = NULL;
+  encoder->last_part_indexes.count = 0;
+  encoder->last_part_indexes.capacity = 0;
+
+  // Build the degree sampler once — every next_part call reuses it (the
+  // alias table depends only on the fragment count). Mirrors the decoder's
+  // cached sampler; draw-for-draw identical to the per-part build.
+  // Interop-critical math, see fountain_utils.c.
+  return encoder->seq_len == 0 ||
+         degree_sampler_init(&encoder->degree_sampler, encoder->seq_len);
+}
+
 fountain_encoder_t *fountain_encoder_new(const uint8_t *message,
                                          size_t message_len,
                                          size_t max_fragment_len,
@@ -360,35 +379,93 @@ fountain_encoder_t *fountain_encoder_new(const uint8_t *message,
     free(encoder);
     return NULL;
   }
+  encoder->seq_len = encoder->fragments.count;
 
-  encoder->seq_num = first_seq_num;
+  if (!encoder_init_sequence(encoder, first_seq_num)) {
+    fountain_encoder_free(encoder);
+    return NULL;
+  }
 
-  // Initialize last_part_indexes (allocate it properly)
-  encoder->last_part_indexes.indexes = NULL;
-  encoder->last_part_indexes.count = 0;
-  encoder->last_part_indexes.capacity = 0;
+  return encoder;
+}
 
-  // Build the degree sampler once — every next_part call reuses it (the
-  // alias table depends only on the fragment count). Mirrors the decoder's
-  // cached sampler; draw-for-draw identical to the per-part build. Must
-  // stay double: interop-critical math, see fountain_utils.c.
-  if (encoder->fragments.count > 0) {
-    double *degree_probs =
-        safe_malloc(encoder->fragments.count * sizeof(double));
-    if (!degree_probs) {
-      fountain_encoder_free(encoder);
-      return NULL;
+// Read fragment index of a source-backed encoder into buf, zero-padding
+// the tail of the last fragment as fountain_encoder_partition_message does
+static bool read_fragment(const fountain_encoder_t *encoder, size_t index,
+                          uint8_t *buf) {
+  size_t offset = index * encoder->fragment_len;
+  size_t len = encoder->message_len - offset;
+  if (len > encoder->fragment_len) {
+    len = encoder->fragment_len;
+  }
+  if (!encoder->source.read(encoder->source.ctx, offset, buf, len)) {
+    return false;
+  }
+  if (len < encoder->fragment_len) {
+    memset(buf + len, 0, encoder->fragment_len - len);
+  }
+  return true;
+}
+
+fountain_encoder_t *
+fountain_encoder_new_from_source(const fountain_source_t *source,
+                                 size_t message_len, size_t max_fragment_len,
+                                 uint32_t first_seq_num,
+                                 size_t min_fragment_len) {
+  if (!source || !source->read) {
+    return NULL;
+  }
+
+  fountain_encoder_t *encoder =
+      (fountain_encoder_t *)calloc(1, sizeof(fountain_encoder_t));
+  if (!encoder) {
+    if (source->close) {
+      source->close(source->ctx);
     }
-    for (size_t i = 0; i < encoder->fragments.count; i++) {
-      degree_probs[i] = 1.0 / (i + 1);
+    return NULL;
+  }
+  encoder->source = *source;
+
+  encoder->message_len = message_len;
+  encoder->fragment_len = fountain_encoder_find_nominal_fragment_length(
+      message_len, min_fragment_len, max_fragment_len);
+  if (encoder->fragment_len == 0 || encoder->fragment_len > UR_LEN_MAX) {
+    fountain_encoder_free(encoder);
+    return NULL;
+  }
+  encoder->seq_len =
+      (message_len + encoder->fragment_len - 1) / encoder->fragment_len;
+  if (encoder->seq_len > UR_INDEX_MAX) {
+    fountain_encoder_free(encoder);
+    return NULL;
+  }
+
+  // The only message-sized state is this one fragment; the checksum pass
+  // reuses it as its read buffer
+  encoder->fragment_buf = (uint8_t *)safe_malloc_uninit(encoder->fragment_len);
+  if (!encoder->fragment_buf) {
+    fountain_encoder_free(encoder);
+    return NULL;
+  }
+
+  uint32_t crc = 0;
+  for (size_t offset = 0; offset < message_len;
+       offset += encoder->fragment_len) {
+    size_t len = message_len - offset;
+    if (len > encoder->fragment_len) {
+      len = encoder->fragment_len;
     }
-    if (!random_sampler_init(&encoder->degree_sampler, degree_probs,
-                             encoder->fragments.count)) {
-      free(degree_probs);
+    if (!source->read(source->ctx, offset, encoder->fragment_buf, len)) {
       fountain_encoder_free(encoder);
       return NULL;
     }
-    free(degree_probs);
+    crc = crc32_update(crc, encoder->fragment_buf, len);
+  }
+  encoder->checksum = crc;
+
+  if (!encoder_init_sequence(encoder, first_seq_num)) {
+    fountain_encoder_free(encoder);
+    return NULL;
   }
 
   return encoder;
@@ -400,22 +477,39 @@ void fountain_encoder_free(fountain_encoder_t *encoder) {
   }
 
   fragment_array_free(&encoder->fragments);
+  if (encoder->source.close) {
+    encoder->source.close(encoder->source.ctx);
+  }
+  safe_free(encoder->fragment_buf);
   // Free indexes array only, not the struct itself (it's embedded)
   free(encoder->last_part_indexes.indexes);
-  random_sampler_free(&encoder->degree_sampler);
+  degree_sampler_free(&encoder->degree_sampler);
   free(encoder);
 }
 
 size_t fountain_encoder_seq_len(const fountain_encoder_t *encoder) {
-  return encoder ? encoder->fragments.count : 0;
+  return encoder ? encoder->seq_len : 0;
 }
 
 bool fountain_encoder_is_single_part(const fountain_encoder_t *encoder) {
-  return encoder && encoder->fragments.count == 1;
+  return encoder && encoder->seq_len == 1;
+}
+
+const uint8_t *fountain_encoder_fragment(fountain_encoder_t *encoder,
+                                         size_t index) {
+  if (!encoder || index >= encoder->seq_len) {
+    return NULL;
+  }
+  if (!encoder->source.read) {
+    return encoder->fragments.fragments[index];
+  }
+  return read_fragment(encoder, index, encoder->fragment_buf)
+             ? encoder->fragment_buf
+             : NULL;
 }
 
 // XOR mix fragments
-static bool mix_fragments(const fountain_encoder_t *encoder,
+static bool mix_fragments(fountain_encoder_t *encoder,
                           const part_indexes_t *indexes, uint8_t **result_out,
                           size_t *result_len) {
   if (!encoder || !indexes || !result_out || !result_len) {
@@ -439,21 +533,39 @@ static bool mix_fragments(const fountain_encoder_t *encoder,
     memset(result, 0, encoder->fragment_len);
   } else {
     size_t first = indexes->indexes[0];
-    if (first >= encoder->fragments.count) {
+    if (first >= encoder->seq_len) {
       free(result);
       return false;
     }
-    memcpy(result, encoder->fragments.fragments[first], encoder->fragment_len);
+    if (encoder->source.read) {
+      // Streamed: the first fragment is read straight into the result
+      if (!read_fragment(encoder, first, result)) {
+        free(result);
+        return false;
+      }
+    } else {
+      memcpy(result, encoder->fragments.fragments[first],
+             encoder->fragment_len);
+    }
   }
 
   for (size_t i = 1; i < indexes->count; i++) {
     size_t index = indexes->indexes[i];
-    if (index >= encoder->fragments.count) {
+    if (index >= encoder->seq_len) {
       free(result);
       return false;
     }
 
-    const uint8_t *fragment = encoder->fragments.fragments[index];
+    const uint8_t *fragment;
+    if (encoder->source.read) {
+      if (!read_fragment(encoder, index, encoder->fragment_buf)) {
+        free(result);
+        return false;
+      }
+      fragment = encoder->fragment_buf;
+    } else {
+      fragment = encoder->fragments.fragments[index];
+    }
     ur_xor_inplace(result, fragment, encoder->fragment_len);
   }
 
@@ -477,7 +589,7 @@ bool fountain_encoder_next_part(fountain_encoder_t *encoder,
     return false;
   }
 
-  if (!choose_fragments_cached(encoder->seq_num, encoder->fragments.count,
+  if (!choose_fragments_cached(encoder->seq_num, encoder->seq_len,
                                encoder->checksum, indexes,
                                &encoder->degree_sampler)) {
     part_indexes_free(indexes);
@@ -501,7 +613,7 @@ bool fountain_encoder_next_part(fountain_encoder_t *encoder,
 
   // Fill part structure
   part->seq_num = encoder->seq_num;
-  part->seq_len = encoder->fragments.count;
+  part->seq_len = encoder->seq_len;
   part->message_len = encoder->message_len;
   part->checksum = encoder->checksum;
   part->data = mixed_data;
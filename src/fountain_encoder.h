@@ -3,6 +3,7 @@
 
 #include "fountain_types.h"
 #include "fountain_utils.h"
+#include "ur_export.h"
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
@@ -18,22 +19,38 @@ typedef struct fountain_encoder fountain_encoder_t;
 // Fragment storage (array of byte arrays)
 typedef struct {
   uint8_t **fragments;
-  size_t *fragment_lens;
-  size_t count;
-  size_t capacity;
+  ur_len_t *fragment_lens;
+  ur_index_t count;
+  ur_index_t capacity;
 } fragment_array_t;
 
+// Pull-based message input, for encoding a message that is not held in one
+// contiguous buffer (a file, flash, a chunked store). read() fills buf with
+// len bytes of the message starting at offset; the range always lies inside
+// the message. close(), if set, releases ctx when the encoder is done.
+typedef struct {
+  bool (*read)(void *ctx, size_t offset, uint8_t *buf, size_t len);
+  void (*close)(void *ctx);
+  void *ctx;
+} fountain_source_t;
+
 // Fountain encoder structure
 typedef struct fountain_encoder {
   size_t message_len;
   uint32_t checksum;
   size_t fragment_len;
+  size_t seq_len;
+  // Either the partitioned message (fountain_encoder_new) or, when
+  // source.read is set, nothing: fragments are read on demand into
+  // fragment_buf (fountain_encoder_new_from_source)
   fragment_array_t fragments;
+  fountain_source_t source;
+  uint8_t *fragment_buf;
   uint32_t seq_num;
   part_indexes_t last_part_indexes;
   // Degree sampler cached across next_part calls — the alias table depends
-  // only on seq_len. Interop-critical double math; see fountain_utils.c.
-  random_sampler_t degree_sampler;
+  // only on seq_len. Interop-critical math; see fountain_utils.c.
+  degree_sampler_t degree_sampler;
 } fountain_encoder_t;
 
 /**
@@ -43,9 +60,8 @@ typedef struct fountain_encoder {
  * @param max_fragment_len Maximum fragment length
  * @return Optimal fragment length, or 0 on error
  */
-size_t fountain_encoder_find_nominal_fragment_length(size_t message_len,
-                                                     size_t min_fragment_len,
-                                                     size_t max_fragment_len);
+UR_API size_t fountain_encoder_find_nominal_fragment_length(
+    size_t message_len, size_t min_fragment_len, size_t max_fragment_len);
 
 /**
  * Partition message into fragments
@@ -53,11 +69,13 @@ size_t fountain_encoder_find_nominal_fragment_length(size_t message_len,
  * @param message_len Message length
  * @param fragment_len Fragment length
  * @param fragments Output fragment array (allocated by function)
- * @return true on success
+ * @return true on success; false on error, including more than
+ *         UR_INDEX_MAX fragments or fragment_len above UR_LEN_MAX
  */
-bool fountain_encoder_partition_message(const uint8_t *message,
-                                        size_t message_len, size_t fragment_len,
-                                        fragment_array_t *fragments);
+UR_API bool fountain_encoder_partition_message(const uint8_t *message,
+                                               size_t message_len,
+                                               size_t fragment_len,
+                                               fragment_array_t *fragments);
 
 /**
  * Create new fountain encoder
@@ -66,33 +84,65 @@ bool fountain_encoder_partition_message(const uint8_t *message,
  * @param max_fragment_len Maximum fragment length
  * @param first_seq_num First sequence number (default 0)
  * @param min_fragment_len Minimum fragment length (default 10)
- * @return Pointer to encoder or NULL on error
+ * @return Pointer to encoder or NULL on error (including a message that
+ *         would need more than UR_INDEX_MAX fragments)
+ */
+UR_API fountain_encoder_t *fountain_encoder_new(const uint8_t *message,
+                                                size_t message_len,
+                                                size_t max_fragment_len,
+                                                uint32_t first_seq_num,
+                                                size_t min_fragment_len);
+
+/**
+ * Create a fountain encoder that reads the message from a source instead of
+ * copying it: one streaming pass computes the checksum, and each part reads
+ * the fragments it mixes. Memory use is one fragment whatever message_len
+ * is; parts are identical to fountain_encoder_new() over the same bytes.
+ * @param source Message source; the encoder owns it from this call on and
+ *               calls source->close (if set) when freed, or before
+ *               returning NULL
+ * @param message_len Message length
+ * @param max_fragment_len Maximum fragment length
+ * @param first_seq_num First sequence number (default 0)
+ * @param min_fragment_len Minimum fragment length (default 10)
+ * @return Pointer to encoder or NULL on error (including a failed read)
  */
-fountain_encoder_t *fountain_encoder_new(const uint8_t *message,
-                                         size_t message_len,
-                                         size_t max_fragment_len,
-                                         uint32_t first_seq_num,
-                                         size_t min_fragment_len);
+UR_API fountain_encoder_t *
+fountain_encoder_new_from_source(const fountain_source_t *source,
+                                 size_t message_len, size_t max_fragment_len,
+                                 uint32_t first_seq_num,
+                                 size_t min_fragment_len);
 
 /**
  * Free fountain encoder
  * @param encoder Pointer to encoder
  */
-void fountain_encoder_free(fountain_encoder_t *encoder);
+UR_API void fountain_encoder_free(fountain_encoder_t *encoder);
 
 /**
  * Get sequence length (total number of fragments)
  * @param encoder Pointer to encoder
  * @return Sequence length
  */
-size_t fountain_encoder_seq_len(const fountain_encoder_t *encoder);
+UR_API size_t fountain_encoder_seq_len(const fountain_encoder_t *encoder);
+
+/**
+ * Get the (zero-padded) contents of one fragment. For an encoder built from
+ * a source this reads into the encoder's scratch buffer, which the next
+ * call or part overwrites.
+ * @param encoder Pointer to encoder
+ * @param index Fragment index (< seq_len)
+ * @return fragment_len bytes, or NULL on error
+ */
+UR_API const uint8_t *fountain_encoder_fragment(fountain_encoder_t *encoder,
+                                                size_t index);
 
 /**
  * Check if encoder will generate only single part
  * @param encoder Pointer to encoder
  * @return true if single part
  */
-bool fountain_encoder_is_single_part(const fountain_encoder_t *encoder);
+UR_API bool fountain_encoder_is_single_part(const fountain_encoder_t *encoder);
 
 /**
  * Generate next part
@@ -100,8 +150,8 @@ bool fountain_encoder_is_single_part(const fountain_encoder_t *encoder);
  * @param part Output part (allocated by caller)
  * @return true on success
  */
-bool fountain_encoder_next_part(fountain_encoder_t *encoder,
-                                fountain_encoder_part_t *part);
+UR_API bool fountain_encoder_next_part(fountain_encoder_t *encoder,
+                                       fountain_encoder_part_t *part);
 
 /**
  * Encode part to CBOR
@@ -110,18 +160,19 @@ bool fountain_encoder_next_part(fountain_encoder_t *encoder,
  * @param cbor_len Output CBOR length
  * @return true on success
  */
-bool fountain_encoder_part_to_cbor(const fountain_encoder_part_t *part,
-                                   uint8_t **cbor_out, size_t *cbor_len);
+UR_API bool fountain_encoder_part_to_cbor(const fountain_encoder_part_t *part,
+                                          uint8_t **cbor_out, size_t *cbor_len);
 
 /**
  * Free encoder part data
  * @param part Part to free
  */
-void fountain_encoder_part_free(fountain_encoder_part_t *part);
+UR_API void fountain_encoder_part_free(fountain_encoder_part_t *part);
 
 // Fragment array operations
-bool fragment_array_init(fragment_array_t *arr, size_t capacity);
-void fragment_array_free(fragment_array_t *arr);
-bool fragment_array_add(fragment_array_t *arr, const uint8_t *data, size_t len);
+UR_INTERNAL bool fragment_array_init(fragment_array_t *arr, size_t capacity);
+UR_INTERNAL void fragment_array_free(fragment_array_t *arr);
+UR_INTERNAL bool fragment_array_add(fragment_array_t *arr, const uint8_t *data,
+                                    size_t len);
 
 #endif // FOUNTAIN_ENCODER_H
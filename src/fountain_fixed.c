@@ -0,0 +1,335 @@
+//
+// fountain_fixed.c
+//
+// Copyright © 2025 Krux Contributors
+// Licensed under the "BSD-2-Clause Plus Patent License"
+//
+// Integer implementation of the fountain degree sampler and shuffle draw.
+//
+// The reference path (fountain_utils.c) is IEEE double arithmetic and must
+// stay bit-identical with the other UR implementations. Every value it
+// computes is non-negative and normal, so each one is carried here as
+// m * 2^e with a 53-bit m, and each operation (conversion, +, -, *, /) is
+// rounded to 53 bits with ties-to-even exactly as the FPU would. Alias
+// thresholds are stored as IEEE bit patterns: for non-negative doubles,
+// comparing the patterns as integers orders them like the values.
+//
+
+#include "fountain_fixed.h"
+#include "utils.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define SOFT_DOUBLE_BITS 53
+#define DOUBLE_EXPONENT_BIAS 1023
+
+// Non-negative double: m * 2^e, with m == 0 or 2^52 <= m < 2^53
+typedef struct {
+  uint64_t m;
+  int e;
+} soft_double_t;
+
+// Unsigned 128-bit intermediate (products and aligned sums)
+typedef struct {
+  uint64_t hi;
+  uint64_t lo;
+} u128_t;
+
+static u128_t u128_shl(u128_t x, unsigned n) {
+  if (n == 0)
+    return x;
+  if (n >= 64)
+    return (u128_t){x.lo << (n - 64), 0};
+  return (u128_t){(x.hi << n) | (x.lo >> (64 - n)), x.lo << n};
+}
+
+static u128_t u128_shr(u128_t x, unsigned n) {
+  if (n == 0)
+    return x;
+  if (n >= 64)
+    return (u128_t){0, x.hi >> (n - 64)};
+  return (u128_t){x.hi >> n, (x.lo >> n) | (x.hi << (64 - n))};
+}
+
+static u128_t u128_add(u128_t a, u128_t b) {
+  uint64_t lo = a.lo + b.lo;
+  return (u128_t){a.hi + b.hi + (lo < a.lo), lo};
+}
+
+static u128_t u128_sub(u128_t a, u128_t b) {
+  return (u128_t){a.hi - b.hi - (a.lo < b.lo), a.lo - b.lo};
+}
+
+static int u128_cmp(u128_t a, u128_t b) {
+  if (a.hi != b.hi)
+    return a.hi < b.hi ? -1 : 1;
+  if (a.lo != b.lo)
+    return a.lo < b.lo ? -1 : 1;
+  return 0;
+}
+
+// Full 64x64-bit product from 32-bit limbs (no 128-bit type on 32-bit MCUs)
+static u128_t u128_mul(uint64_t a, uint64_t b) {
+  uint64_t a_lo = a & 0xFFFFFFFFu, a_hi = a >> 32;
+  uint64_t b_lo = b & 0xFFFFFFFFu, b_hi = b >> 32;
+  uint64_t ll = a_lo * b_lo, lh = a_lo * b_hi;
+  uint64_t hl = a_hi * b_lo, hh = a_hi * b_hi;
+  uint64_t mid = (ll >> 32) + (lh & 0xFFFFFFFFu) + (hl & 0xFFFFFFFFu);
+  return (u128_t){hh + (lh >> 32) + (hl >> 32) + (mid >> 32),
+                  (mid << 32) | (ll & 0xFFFFFFFFu)};
+}
+
+static unsigned u64_bit_length(uint64_t x) {
+#if defined(__GNUC__)
+  return x ? 64u - (unsigned)__builtin_clzll(x) : 0u;
+#else
+  unsigned len = 0;
+  while (x) {
+    x >>= 1;
+    len++;
+  }
+  return len;
+#endif
+}
+
+static unsigned u128_bit_length(u128_t x) {
+  return x.hi ? 64u + u64_bit_length(x.hi) : u64_bit_length(x.lo);
+}
+
+// Round x * 2^e to 53 bits, ties to even. sticky marks nonzero bits below
+// x's lowest bit; callers that set it pass at least 55 significant bits, so
+// those bits only ever break a tie.
+static soft_double_t sd_round(u128_t x, int e, bool sticky) {
+  unsigned len = u128_bit_length(x);
+  if (len == 0)
+    return (soft_double_t){0, 0};
+  if (len <= SOFT_DOUBLE_BITS) {
+    unsigned shift = SOFT_DOUBLE_BITS - len;
+    return (soft_double_t){x.lo << shift, e - (int)shift};
+  }
+
+  unsigned shift = len - SOFT_DOUBLE_BITS;
+  uint64_t m = u128_shr(x, shift).lo;
+  u128_t rem = u128_sub(x, u128_shl((u128_t){0, m}, shift));
+  int cmp = u128_cmp(rem, u128_shl((u128_t){0, 1}, shift - 1));
+  if (cmp > 0 || (cmp == 0 && (sticky || (m & 1)))) {
+    m++;
+    if (m >> SOFT_DOUBLE_BITS) {
+      m >>= 1;
+      shift++;
+    }
+  }
+  return (soft_double_t){m, e + (int)shift};
+}
+
+static soft_double_t sd_from_u64(uint64_t v) {
+  return sd_round((u128_t){0, v}, 0, false);
+}
+
+// (double)v / 2^64, as prng_next_double() computes it
+static soft_double_t sd_unit(uint64_t v) {
+  soft_double_t r = sd_from_u64(v);
+  if (r.m)
+    r.e -= 64;
+  return r;
+}
+
+static soft_double_t sd_mul(soft_double_t a, soft_double_t b) {
+  if (!a.m || !b.m)
+    return (soft_double_t){0, 0};
+  return sd_round(u128_mul(a.m, b.m), a.e + b.e, false);
+}
+
+// a / b for b != 0: 63 quotient bits by restoring division, remainder as
+// the sticky bit
+static soft_double_t sd_div(soft_double_t a, soft_double_t b) {
+  if (!a.m)
+    return (soft_double_t){0, 0};
+
+  uint64_t q = a.m / b.m;
+  uint64_t r = a.m % b.m;
+  for (int i = 0; i < 63; i++) {
+    r <<= 1;
+    q <<= 1;
+    if (r >= b.m) {
+      r -= b.m;
+      q |= 1;
+    }
+  }
+  return sd_round((u128_t){0, q}, a.e - b.e - 63, r != 0);
+}
+
+// Align b (b <= a) under a with 64 guard bits: returns b's mantissa
+// shifted into a's frame, with the bits shifted out reported as sticky
+static u128_t sd_align(soft_double_t a, soft_double_t b, bool *sticky) {
+  unsigned d = (unsigned)(a.e - b.e);
+  u128_t y = {b.m, 0};
+  if (d >= 128) {
+    *sticky = true;
+    return (u128_t){0, 0};
+  }
+  u128_t shifted = u128_shr(y, d);
+  *sticky = u128_cmp(u128_shl(shifted, d), y) != 0;
+  return shifted;
+}
+
+static soft_double_t sd_add(soft_double_t a, soft_double_t b) {
+  if (!b.m)
+    return a;
+  if (!a.m)
+    return b;
+  if (a.e < b.e) {
+    soft_double_t t = a;
+    a = b;
+    b = t;
+  }
+
+  bool sticky;
+  u128_t y = sd_align(a, b, &sticky);
+  return sd_round(u128_add((u128_t){a.m, 0}, y), a.e - 64, sticky);
+}
+
+// a - b for a >= b
+static soft_double_t sd_sub(soft_double_t a, soft_double_t b) {
+  if (!b.m)
+    return a;
+
+  bool sticky;
+  u128_t y = sd_align(a, b, &sticky);
+  u128_t diff = u128_sub((u128_t){a.m, 0}, y);
+  if (sticky) {
+    // The true b is a fraction above y: borrow one and keep the fraction
+    // as sticky bits
+    diff = u128_sub(diff, (u128_t){0, 1});
+  }
+  return sd_round(diff, a.e - 64, sticky);
+}
+
+static bool sd_less(soft_double_t a, soft_double_t b) {
+  if (!a.m || !b.m)
+    return b.m != 0 && !a.m;
+  if (a.e != b.e)
+    return a.e < b.e;
+  return a.m < b.m;
+}
+
+// The IEEE-754 binary64 encoding of a
+static uint64_t sd_bits(soft_double_t a) {
+  if (!a.m)
+    return 0;
+  uint64_t exponent = (uint64_t)(a.e + (SOFT_DOUBLE_BITS - 1) +
+                                 DOUBLE_EXPONENT_BIAS);
+  return (exponent << (SOFT_DOUBLE_BITS - 1)) |
+         (a.m & ((UINT64_C(1) << (SOFT_DOUBLE_BITS - 1)) - 1));
+}
+
+// Truncation toward zero, as a C cast to an integer type
+static uint64_t sd_trunc(soft_double_t a) {
+  if (!a.m || a.e <= -SOFT_DOUBLE_BITS)
+    return 0;
+  if (a.e >= 0)
+    return a.m << a.e;
+  return a.m >> -a.e;
+}
+
+bool fixed_sampler_init(fixed_sampler_t *sampler, size_t count) {
+  if (!sampler || count == 0 || count > UR_INDEX_MAX)
+    return false;
+
+  sampler->probs = safe_malloc(count * sizeof(uint64_t));
+  sampler->aliases = safe_malloc(count * sizeof(ur_index_t));
+  soft_double_t *P = safe_malloc(count * sizeof(soft_double_t));
+  ur_index_t *small = safe_malloc(count * sizeof(ur_index_t));
+  ur_index_t *large = safe_malloc(count * sizeof(ur_index_t));
+  if (!sampler->probs || !sampler->aliases || !P || !small || !large) {
+    free(P);
+    free(small);
+    free(large);
+    fixed_sampler_free(sampler);
+    return false;
+  }
+  sampler->count = count;
+
+  // Same operations, in the same order, as the degree weights built by
+  // degree_sampler_init() and then random_sampler_init()
+  const soft_double_t one = sd_from_u64(1);
+  soft_double_t total = {0, 0};
+  for (size_t i = 0; i < count; i++) {
+    P[i] = sd_div(one, sd_from_u64(i + 1));
+    total = sd_add(total, P[i]);
+  }
+  const soft_double_t n = sd_from_u64(count);
+  for (size_t i = 0; i < count; i++) {
+    P[i] = sd_div(sd_mul(P[i], n), total);
+  }
+
+  size_t small_size = 0, large_size = 0;
+  for (size_t i = count; i-- > 0;) {
+    if (sd_less(P[i], one)) {
+      small[small_size++] = (ur_index_t)i;
+    } else {
+      large[large_size++] = (ur_index_t)i;
+    }
+  }
+
+  while (small_size > 0 && large_size > 0) {
+    ur_index_t a = small[--small_size];
+    ur_index_t g = large[--large_size];
+
+    sampler->probs[a] = sd_bits(P[a]);
+    sampler->aliases[a] = g;
+    P[g] = sd_sub(sd_add(P[g], P[a]), one);
+
+    if (sd_less(P[g], one)) {
+      small[small_size++] = g;
+    } else {
+      large[large_size++] = g;
+    }
+  }
+
+  while (large_size > 0) {
+    sampler->probs[large[--large_size]] = sd_bits(one);
+  }
+  while (small_size > 0) {
+    sampler->probs[small[--small_size]] = sd_bits(one);
+  }
+
+  free(P);
+  free(small);
+  free(large);
+  return true;
+}
+
+void fixed_sampler_free(fixed_sampler_t *sampler) {
+  if (!sampler)
+    return;
+  safe_free(sampler->probs);
+  safe_free(sampler->aliases);
+  sampler->count = 0;
+}
+
+int fixed_sampler_next(const fixed_sampler_t *sampler, prng_state_t *rng) {
+  if (!sampler || !sampler->probs || !sampler->aliases || sampler->count == 0)
+    return 0;
+
+  soft_double_t r1 = sd_unit(prng_next_uint64(rng));
+  uint64_t r2_bits = sd_bits(sd_unit(prng_next_uint64(rng)));
+  uint64_t i = sd_trunc(sd_mul(sd_from_u64(sampler->count), r1));
+
+  if (i >= sampler->count)
+    i = sampler->count - 1;
+
+  return (r2_bits < sampler->probs[i]) ? (int)i : (int)sampler->aliases[i];
+}
+
+uint32_t fixed_prng_next_int(prng_state_t *prng, uint32_t min, uint32_t max) {
+  if (!prng || min > max)
+    return min;
+
+  soft_double_t range = sd_from_u64((uint32_t)(max - min + 1));
+  soft_double_t rand_val = sd_unit(prng_next_uint64(prng));
+  uint64_t result =
+      sd_trunc(sd_add(sd_mul(rand_val, range), sd_from_u64(min)));
+
+  return (uint32_t)(result & 0xFFFFFFFFULL);
+}
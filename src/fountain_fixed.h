@@ -0,0 +1,53 @@
+#ifndef FOUNTAIN_FIXED_H
+#define FOUNTAIN_FIXED_H
+
+#include "fountain_utils.h"
+#include "ur_export.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Integer twin of the double degree sampler and shuffle draw in
+// fountain_utils.c, for targets without a double-precision FPU (where every
+// double operation is a soft-float library call). Each double operation of
+// the reference path is reproduced exactly, with round-to-nearest-even, on
+// 64-bit integers, so fragment selection stays bit-identical with the
+// reference UR implementations. Building with UR_FIXED_POINT_SAMPLER makes
+// choose_fragments() use these.
+
+/**
+ * Initialize a fixed-point sampler for the fountain degree distribution
+ * (weight 1/(i+1) for degree i+1); the same table random_sampler_init()
+ * builds from those weights, bit for bit
+ * @param sampler Fixed-point sampler instance
+ * @param count Number of degrees (seq_len, at most UR_INDEX_MAX)
+ * @return true on success
+ */
+UR_API bool fixed_sampler_init(fixed_sampler_t *sampler, size_t count);
+
+/**
+ * Free fixed-point sampler resources
+ * @param sampler Fixed-point sampler instance
+ */
+UR_API void fixed_sampler_free(fixed_sampler_t *sampler);
+
+/**
+ * Get next sample; consumes the PRNG exactly as random_sampler_next()
+ * @param sampler Fixed-point sampler instance
+ * @param rng PRNG instance
+ * @return Selected index
+ */
+UR_API int fixed_sampler_next(const fixed_sampler_t *sampler,
+                              prng_state_t *rng);
+
+/**
+ * Integer equivalent of prng_next_int()
+ * @param prng PRNG state
+ * @param min Minimum value (inclusive)
+ * @param max Maximum value (inclusive)
+ * @return Random integer, equal to what prng_next_int() returns
+ */
+UR_API uint32_t fixed_prng_next_int(prng_state_t *prng, uint32_t min,
+                                    uint32_t max);
+
+#endif // FOUNTAIN_FIXED_H
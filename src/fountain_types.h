@@ -1,15 +1,50 @@
 #ifndef FOUNTAIN_TYPES_H
 #define FOUNTAIN_TYPES_H
 
+#include "ur_export.h"
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 
+// Fragment indexes, and the counts and capacities of index arrays, are
+// ur_index_t: 16 bits by default, enough for any seq_len up to
+// UR_INDEX_MAX (the UR decoder caps seq_len at UR_MAX_SEQ_LEN, 1024).
+// Build with UR_INDEX_BITS=32 for longer sequences. Fragment payload
+// lengths are ur_len_t.
+#ifndef UR_INDEX_BITS
+#define UR_INDEX_BITS 16
+#endif
+
+#if UR_INDEX_BITS == 16
+typedef uint16_t ur_index_t;
+#define UR_INDEX_MAX UINT16_MAX
+#elif UR_INDEX_BITS == 32
+typedef uint32_t ur_index_t;
+#define UR_INDEX_MAX UINT32_MAX
+#else
+#error "UR_INDEX_BITS must be 16 or 32"
+#endif
+
+typedef uint32_t ur_len_t;
+#define UR_LEN_MAX UINT32_MAX
+
+// Next capacity of a growing ur_index_t-counted array: initial, then
+// doubling, saturating at UR_INDEX_MAX. Returns capacity unchanged once it
+// is already UR_INDEX_MAX, which callers must treat as full.
+static inline ur_index_t ur_index_grow(ur_index_t capacity,
+                                       ur_index_t initial) {
+  if (capacity == 0)
+    return initial;
+  if (capacity > UR_INDEX_MAX / 2)
+    return UR_INDEX_MAX;
+  return (ur_index_t)(capacity * 2);
+}
+
 // Part indexes set (simplified as dynamic array for C)
 typedef struct {
-  size_t *indexes;
-  size_t count;
-  size_t capacity;
+  ur_index_t *indexes;
+  ur_index_t count;
+  ur_index_t capacity;
 } part_indexes_t;
 
 // Fountain encoder part structure
@@ -26,18 +61,20 @@ typedef struct {
 typedef struct {
   part_indexes_t indexes;
   uint8_t *data;
-  size_t data_len;
+  ur_len_t data_len;
 } decoder_part_t;
 
 // Helper functions for part indexes
-part_indexes_t *part_indexes_new(void);
-void part_indexes_free(part_indexes_t *indexes);
-bool part_indexes_add(part_indexes_t *indexes, size_t index);
-bool part_indexes_contains(const part_indexes_t *indexes, size_t index);
-void part_indexes_clear(part_indexes_t *indexes);
+UR_INTERNAL part_indexes_t *part_indexes_new(void);
+UR_INTERNAL void part_indexes_free(part_indexes_t *indexes);
+UR_INTERNAL bool part_indexes_add(part_indexes_t *indexes, ur_index_t index);
+UR_INTERNAL bool part_indexes_contains(const part_indexes_t *indexes,
+                                       ur_index_t index);
+UR_INTERNAL void part_indexes_clear(part_indexes_t *indexes);
 
 // Part operations
-void decoder_part_free(decoder_part_t *part);
-bool decoder_part_copy(const decoder_part_t *src, decoder_part_t *dst);
+UR_INTERNAL void decoder_part_free(decoder_part_t *part);
+UR_INTERNAL bool decoder_part_copy(const decoder_part_t *src,
+                                   decoder_part_t *dst);
 
 #endif // FOUNTAIN_TYPES_H
@@ -15,10 +15,14 @@
 // fragment selection must stay bit-identical with the reference UR
 // implementations (Python/C++/Swift/JS — all IEEE double). Converting to
 // float, or building with -ffast-math, silently breaks cross-wallet
-// decoding.
+// decoding. UR_FIXED_POINT_SAMPLER swaps in the integer implementation in
+// fountain_fixed.c, which reproduces this math exactly.
 //
 
 #include "fountain_utils.h"
+#ifdef UR_FIXED_POINT_SAMPLER
+#include "fountain_fixed.h"
+#endif
 #include "sha256/sha256_compat.h"
 #include "utils.h"
 #include <stdlib.h>
@@ -33,14 +37,7 @@ static uint64_t rotl(const uint64_t x, int k) {
   return (x << k) | (x >> (64 - k));
 }
 
-void prng_init_from_bytes(prng_state_t *prng, const uint8_t *seed,
-                          size_t seed_len) {
-  if (!prng || !seed)
-    return;
-
-  uint8_t hash[32];
-  compute_sha256(seed, seed_len, hash);
-
+static void prng_init_from_hash(prng_state_t *prng, const uint8_t hash[32]) {
   for (int i = 0; i < 4; i++) {
     prng->state[i] = 0;
     for (int j = 0; j < 8; j++) {
@@ -50,7 +47,17 @@ void prng_init_from_bytes(prng_state_t *prng, const uint8_t *seed,
   }
 }
 
-static uint64_t prng_next_uint64(prng_state_t *prng) {
+void prng_init_from_bytes(prng_state_t *prng, const uint8_t *seed,
+                          size_t seed_len) {
+  if (!prng || !seed)
+    return;
+
+  uint8_t hash[32];
+  compute_sha256(seed, seed_len, hash);
+  prng_init_from_hash(prng, hash);
+}
+
+uint64_t prng_next_uint64(prng_state_t *prng) {
   const uint64_t result = rotl(prng->state[1] * 5, 7) * 9;
   const uint64_t t = prng->state[1] << 17;
 
@@ -186,49 +193,84 @@ int random_sampler_next(random_sampler_t *sampler, prng_state_t *rng) {
   return (r2 < sampler->probs[i]) ? i : sampler->aliases[i];
 }
 
-static size_t choose_degree(size_t seq_len, prng_state_t *prng,
-                            random_sampler_t *cached_sampler) {
-  if (seq_len == 0)
-    return 1;
-
-  if (cached_sampler && cached_sampler->probs) {
-    int degree_index = random_sampler_next(cached_sampler, prng);
-    return (size_t)degree_index + 1;
-  }
+bool degree_sampler_init(degree_sampler_t *sampler, size_t seq_len) {
+#ifdef UR_FIXED_POINT_SAMPLER
+  return fixed_sampler_init(sampler, seq_len);
+#else
+  if (!sampler || seq_len == 0)
+    return false;
 
   double *degree_probs = safe_malloc(seq_len * sizeof(double));
   if (!degree_probs)
-    return 1;
+    return false;
 
   for (size_t i = 0; i < seq_len; i++) {
     degree_probs[i] = 1.0 / (i + 1);
   }
 
-  random_sampler_t sampler = {0};
-  if (!random_sampler_init(&sampler, degree_probs, seq_len)) {
-    free(degree_probs);
+  bool ok = random_sampler_init(sampler, degree_probs, seq_len);
+  free(degree_probs);
+  return ok;
+#endif
+}
+
+void degree_sampler_free(degree_sampler_t *sampler) {
+#ifdef UR_FIXED_POINT_SAMPLER
+  fixed_sampler_free(sampler);
+#else
+  random_sampler_free(sampler);
+#endif
+}
+
+static int degree_sampler_next(degree_sampler_t *sampler, prng_state_t *rng) {
+#ifdef UR_FIXED_POINT_SAMPLER
+  return fixed_sampler_next(sampler, rng);
+#else
+  return random_sampler_next(sampler, rng);
+#endif
+}
+
+// Shuffle draw in [0, max]; the fixed-point build's matches prng_next_int()
+static uint32_t shuffle_next_index(prng_state_t *rng, uint32_t max) {
+#ifdef UR_FIXED_POINT_SAMPLER
+  return fixed_prng_next_int(rng, 0, max);
+#else
+  return prng_next_int(rng, 0, max);
+#endif
+}
+
+static size_t choose_degree(size_t seq_len, prng_state_t *prng,
+                            degree_sampler_t *cached_sampler) {
+  if (seq_len == 0)
     return 1;
+
+  if (cached_sampler && cached_sampler->probs) {
+    int degree_index = degree_sampler_next(cached_sampler, prng);
+    return (size_t)degree_index + 1;
   }
 
-  int degree_index = random_sampler_next(&sampler, prng);
-  size_t degree = degree_index + 1;
+  degree_sampler_t sampler = {0};
+  if (!degree_sampler_init(&sampler, seq_len))
+    return 1;
 
-  random_sampler_free(&sampler);
-  free(degree_probs);
+  int degree_index = degree_sampler_next(&sampler, prng);
+  size_t degree = (size_t)degree_index + 1;
+
+  degree_sampler_free(&sampler);
 
   return degree;
 }
 
 static bool choose_fragments_internal(uint32_t seq_num, size_t seq_len,
                                       uint32_t checksum, part_indexes_t *result,
-                                      random_sampler_t *cached_sampler) {
-  if (!result || seq_len == 0)
+                                      degree_sampler_t *cached_sampler) {
+  if (!result || seq_len == 0 || seq_len > UR_INDEX_MAX)
     return false;
 
   part_indexes_clear(result);
 
   if (seq_num <= seq_len) {
-    return part_indexes_add(result, seq_num - 1);
+    return part_indexes_add(result, (ur_index_t)(seq_num - 1));
   }
 
   uint8_t seed[8];
@@ -241,17 +283,20 @@ static bool choose_fragments_internal(uint32_t seq_num, size_t seq_len,
   seed[6] = (checksum >> 8) & 0xff;
   seed[7] = checksum & 0xff;
 
+  // Fixed 8-byte seed: single-block SHA-256 fast path.
+  uint8_t hash[32];
   prng_state_t rng;
-  prng_init_from_bytes(&rng, seed, 8);
+  ur_sha256_8bytes(seed, hash);
+  prng_init_from_hash(&rng, hash);
 
   size_t degree = choose_degree(seq_len, &rng, cached_sampler);
 
-  size_t *remaining_indexes = safe_malloc(seq_len * sizeof(size_t));
+  ur_index_t *remaining_indexes = safe_malloc(seq_len * sizeof(ur_index_t));
   if (!remaining_indexes)
     return false;
 
   for (size_t i = 0; i < seq_len; i++) {
-    remaining_indexes[i] = i;
+    remaining_indexes[i] = (ur_index_t)i;
   }
 
   // Only the first `degree` drawn values matter. Stop after `degree`
@@ -261,7 +306,7 @@ static bool choose_fragments_internal(uint32_t seq_num, size_t seq_len,
   size_t remaining_count = seq_len;
   size_t draws = (degree < seq_len) ? degree : seq_len;
   for (size_t i = 0; i < draws && remaining_count > 0; i++) {
-    uint32_t idx = prng_next_int(&rng, 0, remaining_count - 1);
+    uint32_t idx = shuffle_next_index(&rng, remaining_count - 1);
     if (!part_indexes_add(result, remaining_indexes[idx])) {
       free(remaining_indexes);
       return false;
@@ -283,7 +328,7 @@ bool choose_fragments(uint32_t seq_num, size_t seq_len, uint32_t checksum,
 
 bool choose_fragments_cached(uint32_t seq_num, size_t seq_len,
                              uint32_t checksum, part_indexes_t *result,
-                             random_sampler_t *cached_sampler) {
+                             degree_sampler_t *cached_sampler) {
   return choose_fragments_internal(seq_num, seq_len, checksum, result,
                                    cached_sampler);
 }
@@ -311,11 +356,14 @@ bool part_indexes_is_strict_subset(const part_indexes_t *a,
   return i == a->count;
 }
 
-static bool part_indexes_append_sorted(part_indexes_t *indexes, size_t value) {
+static bool part_indexes_append_sorted(part_indexes_t *indexes,
+                                       ur_index_t value) {
   if (indexes->count >= indexes->capacity) {
-    size_t new_capacity = indexes->capacity == 0 ? 4 : indexes->capacity * 2;
-    size_t *new_idx =
-        safe_realloc(indexes->indexes, new_capacity * sizeof(size_t));
+    ur_index_t new_capacity = ur_index_grow(indexes->capacity, 4);
+    if (new_capacity <= indexes->count)
+      return false;
+    ur_index_t *new_idx =
+        safe_realloc(indexes->indexes, new_capacity * sizeof(ur_index_t));
     if (!new_idx)
       return false;
     indexes->indexes = new_idx;
@@ -376,19 +424,20 @@ bool part_indexes_copy(const part_indexes_t *src, part_indexes_t *dst) {
     return true;
 
   if (dst->capacity < src->count) {
-    size_t *new_idx = safe_realloc(dst->indexes, src->count * sizeof(size_t));
+    ur_index_t *new_idx =
+        safe_realloc(dst->indexes, src->count * sizeof(ur_index_t));
     if (!new_idx)
       return false;
     dst->indexes = new_idx;
     dst->capacity = src->count;
   }
 
-  memcpy(dst->indexes, src->indexes, src->count * sizeof(size_t));
+  memcpy(dst->indexes, src->indexes, src->count * sizeof(ur_index_t));
   dst->count = src->count;
   return true;
 }
 
-bool join_fragments(uint8_t **fragments, size_t *fragment_lens,
+bool join_fragments(uint8_t **fragments, const ur_len_t *fragment_lens,
                     size_t fragment_count, size_t message_len,
                     uint8_t *result) {
   if (!fragments || !fragment_lens || !result || fragment_count == 0)
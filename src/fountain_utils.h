@@ -2,6 +2,7 @@
 #define FOUNTAIN_UTILS_H
 
 #include "fountain_types.h"
+#include "ur_export.h"
 
 // Enable cross-reduction between mixed parts (slower but may use fewer
 // fragments). Uncomment to enable:
@@ -26,14 +27,47 @@ typedef struct {
   size_t count;
 } random_sampler_t;
 
+/**
+ * Integer version of the degree sampler (fountain_fixed.h): the alias
+ * thresholds are the reference doubles' IEEE-754 bit patterns
+ */
+typedef struct {
+  uint64_t *probs;
+  ur_index_t *aliases;
+  size_t count;
+} fixed_sampler_t;
+
+/**
+ * Degree sampler cached by the encoder and decoder: the reference double
+ * sampler, or with UR_FIXED_POINT_SAMPLER its bit-exact integer version
+ * for targets without a double-precision FPU
+ */
+#ifdef UR_FIXED_POINT_SAMPLER
+typedef fixed_sampler_t degree_sampler_t;
+#else
+typedef random_sampler_t degree_sampler_t;
+#endif
+
+// The PRNG, the samplers and choose_fragments() stay UR_API: they are the
+// reference fragment selection, and test_ur_fixed_sampler checks the
+// fixed-point path against them when linked to libur.so. The remaining
+// helpers are UR_INTERNAL.
+
 /**
  * Initialize PRNG with seed using SHA256 (matching Python behavior)
  * @param prng PRNG state
  * @param seed Seed bytes
  * @param seed_len Length of seed
  */
-void prng_init_from_bytes(prng_state_t *prng, const uint8_t *seed,
-                          size_t seed_len);
+UR_API void prng_init_from_bytes(prng_state_t *prng, const uint8_t *seed,
+                                 size_t seed_len);
+
+/**
+ * Generate the next raw 64-bit PRNG output
+ * @param prng PRNG state
+ * @return Random 64-bit value
+ */
+UR_API uint64_t prng_next_uint64(prng_state_t *prng);
 
 /**
  * Generate next random integer in range [min, max]
@@ -42,14 +76,14 @@ void prng_init_from_bytes(prng_state_t *prng, const uint8_t *seed,
  * @param max Maximum value (inclusive)
  * @return Random integer
  */
-uint32_t prng_next_int(prng_state_t *prng, uint32_t min, uint32_t max);
+UR_API uint32_t prng_next_int(prng_state_t *prng, uint32_t min, uint32_t max);
 
 /**
  * Generate next random double in range [0.0, 1.0)
  * @param prng PRNG state
  * @return Random double
  */
-double prng_next_double(prng_state_t *prng);
+UR_API double prng_next_double(prng_state_t *prng);
 
 /**
  * Initialize random sampler with probabilities
@@ -58,14 +92,14 @@ double prng_next_double(prng_state_t *prng);
  * @param count Number of probabilities
  * @return true on success
  */
-bool random_sampler_init(random_sampler_t *sampler, double *probs,
-                         size_t count);
+UR_API bool random_sampler_init(random_sampler_t *sampler, double *probs,
+                                size_t count);
 
 /**
  * Free random sampler resources
  * @param sampler Random sampler instance
  */
-void random_sampler_free(random_sampler_t *sampler);
+UR_API void random_sampler_free(random_sampler_t *sampler);
 
 /**
  * Get next sample from random sampler
@@ -73,7 +107,21 @@ void random_sampler_free(random_sampler_t *sampler);
  * @param rng PRNG instance
  * @return Selected index
  */
-int random_sampler_next(random_sampler_t *sampler, prng_state_t *rng);
+UR_API int random_sampler_next(random_sampler_t *sampler, prng_state_t *rng);
+
+/**
+ * Initialize the fountain degree sampler (weight 1/(i+1) for degree i+1)
+ * @param sampler Degree sampler instance
+ * @param seq_len Number of fragments
+ * @return true on success
+ */
+UR_INTERNAL bool degree_sampler_init(degree_sampler_t *sampler, size_t seq_len);
+
+/**
+ * Free degree sampler resources
+ * @param sampler Degree sampler instance
+ */
+UR_INTERNAL void degree_sampler_free(degree_sampler_t *sampler);
 
 /**
  * Choose fragments for a fountain encoder part
@@ -81,10 +129,10 @@ int random_sampler_next(random_sampler_t *sampler, prng_state_t *rng);
  * @param seq_len Total sequence length
  * @param checksum Message checksum
  * @param result Output part indexes
- * @return true on success
+ * @return true on success (false if seq_len exceeds UR_INDEX_MAX)
  */
-bool choose_fragments(uint32_t seq_num, size_t seq_len, uint32_t checksum,
-                      part_indexes_t *result);
+UR_API bool choose_fragments(uint32_t seq_num, size_t seq_len,
+                             uint32_t checksum, part_indexes_t *result);
 
 /**
  * Choose fragments with a pre-initialized degree sampler (avoids repeated
@@ -96,9 +144,10 @@ bool choose_fragments(uint32_t seq_num, size_t seq_len, uint32_t checksum,
  * @param cached_sampler Pre-initialized sampler (or NULL to create one)
  * @return true on success
  */
-bool choose_fragments_cached(uint32_t seq_num, size_t seq_len,
-                             uint32_t checksum, part_indexes_t *result,
-                             random_sampler_t *cached_sampler);
+UR_INTERNAL bool choose_fragments_cached(uint32_t seq_num, size_t seq_len,
+                                         uint32_t checksum,
+                                         part_indexes_t *result,
+                                         degree_sampler_t *cached_sampler);
 
 /**
  * Check if part_indexes_a is strict subset of part_indexes_b
@@ -106,8 +155,8 @@ bool choose_fragments_cached(uint32_t seq_num, size_t seq_len,
  * @param b Second set
  * @return true if a is strict subset of b
  */
-bool part_indexes_is_strict_subset(const part_indexes_t *a,
-                                   const part_indexes_t *b);
+UR_INTERNAL bool part_indexes_is_strict_subset(const part_indexes_t *a,
+                                               const part_indexes_t *b);
 
 /**
  * Set difference: result = a - b
@@ -116,8 +165,9 @@ bool part_indexes_is_strict_subset(const part_indexes_t *a,
  * @param result Output set (a - b)
  * @return true on success
  */
-bool part_indexes_difference(const part_indexes_t *a, const part_indexes_t *b,
-                             part_indexes_t *result);
+UR_INTERNAL bool part_indexes_difference(const part_indexes_t *a,
+                                         const part_indexes_t *b,
+                                         part_indexes_t *result);
 
 /**
  * Check if two part_indexes are equal
@@ -125,7 +175,8 @@ bool part_indexes_difference(const part_indexes_t *a, const part_indexes_t *b,
  * @param b Second set
  * @return true if equal
  */
-bool part_indexes_equal(const part_indexes_t *a, const part_indexes_t *b);
+UR_INTERNAL bool part_indexes_equal(const part_indexes_t *a,
+                                    const part_indexes_t *b);
 
 /**
  * Copy part_indexes
@@ -133,7 +184,8 @@ bool part_indexes_equal(const part_indexes_t *a, const part_indexes_t *b);
  * @param dst Destination
  * @return true on success
  */
-bool part_indexes_copy(const part_indexes_t *src, part_indexes_t *dst);
+UR_INTERNAL bool part_indexes_copy(const part_indexes_t *src,
+                                   part_indexes_t *dst);
 
 #ifdef ENABLE_CROSS_REDUCTION
 /**
@@ -142,8 +194,8 @@ bool part_indexes_copy(const part_indexes_t *src, part_indexes_t *dst);
  * @param b Second set
  * @return true if they share any indexes
  */
-bool part_indexes_have_intersection(const part_indexes_t *a,
-                                    const part_indexes_t *b);
+UR_INTERNAL bool part_indexes_have_intersection(const part_indexes_t *a,
+                                                const part_indexes_t *b);
 
 /**
  * Calculate symmetric difference between two part_indexes sets
@@ -152,9 +204,9 @@ bool part_indexes_have_intersection(const part_indexes_t *a,
  * @param result Output set (A ⊕ B)
  * @return true on success
  */
-bool part_indexes_symmetric_difference(const part_indexes_t *a,
-                                       const part_indexes_t *b,
-                                       part_indexes_t *result);
+UR_INTERNAL bool part_indexes_symmetric_difference(const part_indexes_t *a,
+                                                   const part_indexes_t *b,
+                                                   part_indexes_t *result);
 #endif // ENABLE_CROSS_REDUCTION
 
 /**
@@ -166,7 +218,9 @@ bool part_indexes_symmetric_difference(const part_indexes_t *a,
  * @param result Output buffer (allocated by caller)
  * @return true on success
  */
-bool join_fragments(uint8_t **fragments, size_t *fragment_lens,
-                    size_t fragment_count, size_t message_len, uint8_t *result);
+UR_INTERNAL bool join_fragments(uint8_t **fragments,
+                                const ur_len_t *fragment_lens,
+                                size_t fragment_count, size_t message_len,
+                                uint8_t *result);
 
 #endif // FOUNTAIN_UTILS_H
@@ -14,9 +14,42 @@
 
 /*************************** HEADER FILES ***************************/
 #include "sha256.h"
+#include "sha256_8bytes.h"
+#include <stdbool.h>
 #include <stdlib.h>
 #include <string.h>
 
+// Hardware compression backends, picked once at runtime by CPU feature
+// detection. UR_NO_SHA256_ACCEL keeps only the portable transform.
+#if !defined(UR_NO_SHA256_ACCEL) && defined(__x86_64__) &&                     \
+    (defined(__GNUC__) || defined(__clang__))
+#define UR_SHA256_X86_SHANI 1
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
+
+#if !defined(UR_NO_SHA256_ACCEL) && defined(__aarch64__)
+#if defined(__ARM_FEATURE_SHA2) || defined(__ARM_FEATURE_CRYPTO)
+#define UR_SHA256_ARMV8 1
+#define UR_SHA256_ARMV8_TARGET
+#elif defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 8 &&             \
+    defined(__linux__)
+// GCC's arm_neon.h exposes the crypto intrinsics to functions that opt in
+// via the target attribute, so a baseline armv8-a build can still carry
+// the accelerated path behind the HWCAP check.
+#define UR_SHA256_ARMV8 1
+#define UR_SHA256_ARMV8_TARGET __attribute__((target("+crypto")))
+#endif
+#endif
+
+#if defined(UR_SHA256_ARMV8)
+#include <arm_neon.h>
+#if defined(__linux__)
+#include <asm/hwcap.h>
+#include <sys/auxv.h>
+#endif
+#endif
+
 /****************************** MACROS ******************************/
 #define ROTLEFT(a, b) (((a) << (b)) | ((a) >> (32 - (b))))
 #define ROTRIGHT(a, b) (((a) >> (b)) | ((a) << (32 - (b))))
@@ -28,6 +61,38 @@
 #define SIG0(x) (ROTRIGHT(x, 7) ^ ROTRIGHT(x, 18) ^ ((x) >> 3))
 #define SIG1(x) (ROTRIGHT(x, 17) ^ ROTRIGHT(x, 19) ^ ((x) >> 10))
 
+#define LOAD_BE32(p)                                                           \
+  (((WORD)(p)[0] << 24) | ((WORD)(p)[1] << 16) | ((WORD)(p)[2] << 8) |        \
+   (WORD)(p)[3])
+
+// One round with the working variables passed in rotated order, so nothing
+// is shuffled between rounds: the new `e` lands in d, the new `a` in h.
+#define ROUND(a, b, c, d, e, f, g, h, i, w)                                    \
+  do {                                                                         \
+    WORD t1 = (h) + EP1(e) + CH(e, f, g) + k[i] + (w);                         \
+    (d) += t1;                                                                 \
+    (h) = t1 + EP0(a) + MAJ(a, b, c);                                          \
+  } while (0)
+
+#define ROUND8(i, W)                                                           \
+  do {                                                                         \
+    ROUND(a, b, c, d, e, f, g, h, (i) + 0, W((i) + 0));                        \
+    ROUND(h, a, b, c, d, e, f, g, (i) + 1, W((i) + 1));                        \
+    ROUND(g, h, a, b, c, d, e, f, (i) + 2, W((i) + 2));                        \
+    ROUND(f, g, h, a, b, c, d, e, (i) + 3, W((i) + 3));                        \
+    ROUND(e, f, g, h, a, b, c, d, (i) + 4, W((i) + 4));                        \
+    ROUND(d, e, f, g, h, a, b, c, (i) + 5, W((i) + 5));                        \
+    ROUND(c, d, e, f, g, h, a, b, (i) + 6, W((i) + 6));                        \
+    ROUND(b, c, d, e, f, g, h, a, (i) + 7, W((i) + 7));                        \
+  } while (0)
+
+// Message schedule kept as a rolling 16-word window: m[i & 15] holds
+// W[i - 16] until round i overwrites it with W[i].
+#define W_LOAD(i) m[i]
+#define W_EXPAND(i)                                                            \
+  (m[(i)&15] += SIG1(m[((i)-2) & 15]) + m[((i)-7) & 15] +                      \
+                SIG0(m[((i)-15) & 15]))
+
 /**************************** VARIABLES *****************************/
 static const WORD k[64] = {
     0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1,
@@ -43,46 +108,223 @@ static const WORD k[64] = {
     0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2};
 
 /*********************** FUNCTION DEFINITIONS ***********************/
-static void ur_bundled_sha256_transform(CRYAL_SHA256_CTX *ctx,
-                                        const BYTE data[]) {
-  WORD a, b, c, d, e, f, g, h, i, j, t1, t2, m[64];
-
-  for (i = 0, j = 0; i < 16; ++i, j += 4)
-    m[i] = ((WORD)data[j] << 24) | ((WORD)data[j + 1] << 16) |
-           ((WORD)data[j + 2] << 8) | (WORD)data[j + 3];
-  for (; i < 64; ++i)
-    m[i] = SIG1(m[i - 2]) + m[i - 7] + SIG0(m[i - 15]) + m[i - 16];
-
-  a = ctx->state[0];
-  b = ctx->state[1];
-  c = ctx->state[2];
-  d = ctx->state[3];
-  e = ctx->state[4];
-  f = ctx->state[5];
-  g = ctx->state[6];
-  h = ctx->state[7];
-
-  for (i = 0; i < 64; ++i) {
-    t1 = h + EP1(e) + CH(e, f, g) + k[i] + m[i];
-    t2 = EP0(a) + MAJ(a, b, c);
-    h = g;
-    g = f;
-    f = e;
-    e = d + t1;
-    d = c;
-    c = b;
-    b = a;
-    a = t1 + t2;
+typedef void (*sha256_blocks_fn)(WORD state[8], const BYTE *data,
+                                 size_t blocks);
+
+static void ur_bundled_sha256_blocks_portable(WORD state[8], const BYTE *data,
+                                              size_t blocks) {
+  WORD a, b, c, d, e, f, g, h, m[16];
+  int i;
+
+  while (blocks--) {
+    for (i = 0; i < 16; ++i)
+      m[i] = LOAD_BE32(data + 4 * i);
+
+    a = state[0];
+    b = state[1];
+    c = state[2];
+    d = state[3];
+    e = state[4];
+    f = state[5];
+    g = state[6];
+    h = state[7];
+
+    ROUND8(0, W_LOAD);
+    ROUND8(8, W_LOAD);
+    for (i = 16; i < 64; i += 8)
+      ROUND8(i, W_EXPAND);
+
+    state[0] += a;
+    state[1] += b;
+    state[2] += c;
+    state[3] += d;
+    state[4] += e;
+    state[5] += f;
+    state[6] += g;
+    state[7] += h;
+    data += 64;
+  }
+}
+
+#if defined(UR_SHA256_X86_SHANI)
+// Four rounds: add the round constants and feed both halves of the
+// message vector through SHA256RNDS2.
+#define SHANI_ROUNDS4(msg, i)                                                  \
+  do {                                                                         \
+    __m128i wk =                                                               \
+        _mm_add_epi32(msg, _mm_loadu_si128((const __m128i *)&k[i]));           \
+    state1 = _mm_sha256rnds2_epu32(state1, state0, wk);                        \
+    wk = _mm_shuffle_epi32(wk, 0x0E);                                          \
+    state0 = _mm_sha256rnds2_epu32(state0, state1, wk);                        \
+  } while (0)
+
+__attribute__((target("sha,sse4.1"))) static void
+ur_bundled_sha256_blocks_shani(WORD state[8], const BYTE *data,
+                               size_t blocks) {
+  const __m128i bswap =
+      _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+  __m128i state0, state1, tmp, abef_save, cdgh_save, w[4];
+  int i;
+
+  // SHA256RNDS2 wants the state split as ABEF / CDGH.
+  tmp = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *)&state[0]), 0xB1);
+  state1 =
+      _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *)&state[4]), 0x1B);
+  state0 = _mm_alignr_epi8(tmp, state1, 8);
+  state1 = _mm_blend_epi16(state1, tmp, 0xF0);
+
+  while (blocks--) {
+    abef_save = state0;
+    cdgh_save = state1;
+
+    for (i = 0; i < 4; ++i)
+      w[i] = _mm_shuffle_epi8(
+          _mm_loadu_si128((const __m128i *)(data + 16 * i)), bswap);
+
+    // w[i & 3] holds W[4i..4i+3] when group i runs; SHA256MSG1/MSG2 build
+    // the later groups in place.
+    for (i = 0; i < 16; ++i) {
+      SHANI_ROUNDS4(w[i & 3], 4 * i);
+      if (i >= 3 && i <= 14) {
+        __m128i *next = &w[(i + 1) & 3];
+        *next = _mm_add_epi32(*next,
+                              _mm_alignr_epi8(w[i & 3], w[(i - 1) & 3], 4));
+        *next = _mm_sha256msg2_epu32(*next, w[i & 3]);
+      }
+      if (i >= 1 && i <= 12)
+        w[(i - 1) & 3] = _mm_sha256msg1_epu32(w[(i - 1) & 3], w[i & 3]);
+    }
+
+    state0 = _mm_add_epi32(state0, abef_save);
+    state1 = _mm_add_epi32(state1, cdgh_save);
+    data += 64;
   }
 
-  ctx->state[0] += a;
-  ctx->state[1] += b;
-  ctx->state[2] += c;
-  ctx->state[3] += d;
-  ctx->state[4] += e;
-  ctx->state[5] += f;
-  ctx->state[6] += g;
-  ctx->state[7] += h;
+  tmp = _mm_shuffle_epi32(state0, 0x1B);
+  state1 = _mm_shuffle_epi32(state1, 0xB1);
+  state0 = _mm_blend_epi16(tmp, state1, 0xF0);
+  state1 = _mm_alignr_epi8(state1, tmp, 8);
+  _mm_storeu_si128((__m128i *)&state[0], state0);
+  _mm_storeu_si128((__m128i *)&state[4], state1);
+}
+
+static bool ur_bundled_sha256_cpu_has_shani(void) {
+  unsigned int eax, ebx, ecx, edx;
+  if (__get_cpuid_max(0, NULL) < 7)
+    return false;
+  __cpuid(1, eax, ebx, ecx, edx);
+  if (!(ecx & (1u << 19)) || !(ecx & (1u << 9))) // SSE4.1, SSSE3
+    return false;
+  __cpuid_count(7, 0, eax, ebx, ecx, edx);
+  return (ebx & (1u << 29)) != 0; // SHA
+}
+#endif // UR_SHA256_X86_SHANI
+
+#if defined(UR_SHA256_ARMV8)
+UR_SHA256_ARMV8_TARGET static void
+ur_bundled_sha256_blocks_armv8(WORD state[8], const BYTE *data,
+                               size_t blocks) {
+  uint32x4_t abcd = vld1q_u32((const uint32_t *)&state[0]);
+  uint32x4_t efgh = vld1q_u32((const uint32_t *)&state[4]);
+  uint32x4_t w[4];
+  int i;
+
+  while (blocks--) {
+    uint32x4_t abcd_save = abcd;
+    uint32x4_t efgh_save = efgh;
+
+    for (i = 0; i < 4; ++i)
+      w[i] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(data + 16 * i)));
+
+    // w[i & 3] holds W[4i..4i+3] when group i runs and is then replaced
+    // by W[4i+16..4i+19] for group i + 4.
+    for (i = 0; i < 16; ++i) {
+      uint32x4_t wk =
+          vaddq_u32(w[i & 3], vld1q_u32((const uint32_t *)&k[4 * i]));
+      uint32x4_t abcd_prev = abcd;
+      if (i < 12)
+        w[i & 3] = vsha256su1q_u32(vsha256su0q_u32(w[i & 3], w[(i + 1) & 3]),
+                                   w[(i + 2) & 3], w[(i + 3) & 3]);
+      abcd = vsha256hq_u32(abcd, efgh, wk);
+      efgh = vsha256h2q_u32(efgh, abcd_prev, wk);
+    }
+
+    abcd = vaddq_u32(abcd, abcd_save);
+    efgh = vaddq_u32(efgh, efgh_save);
+    data += 64;
+  }
+
+  vst1q_u32((uint32_t *)&state[0], abcd);
+  vst1q_u32((uint32_t *)&state[4], efgh);
+}
+
+static bool ur_bundled_sha256_cpu_has_armv8(void) {
+#if defined(__linux__) && defined(HWCAP_SHA2)
+  return (getauxval(AT_HWCAP) & HWCAP_SHA2) != 0;
+#else
+  // Compiled with the feature enabled: the target baseline guarantees it.
+  return true;
+#endif
+}
+#endif // UR_SHA256_ARMV8
+
+static sha256_blocks_fn ur_bundled_sha256_select(void) {
+#if defined(UR_SHA256_X86_SHANI)
+  if (ur_bundled_sha256_cpu_has_shani())
+    return ur_bundled_sha256_blocks_shani;
+#endif
+#if defined(UR_SHA256_ARMV8)
+  if (ur_bundled_sha256_cpu_has_armv8())
+    return ur_bundled_sha256_blocks_armv8;
+#endif
+  return ur_bundled_sha256_blocks_portable;
+}
+
+// Detection runs on first use. Threads racing on the first hash each store
+// the same pointer; the atomic accesses are relaxed because the pointer
+// publishes no data, only code.
+static sha256_blocks_fn ur_bundled_sha256_blocks_impl = NULL;
+
+// The selected backend; callers load it once and use the local copy
+static sha256_blocks_fn ur_bundled_sha256_backend(void) {
+#if defined(__GNUC__) || defined(__clang__)
+  sha256_blocks_fn impl =
+      __atomic_load_n(&ur_bundled_sha256_blocks_impl, __ATOMIC_RELAXED);
+  if (!impl) {
+    impl = ur_bundled_sha256_select();
+    __atomic_store_n(&ur_bundled_sha256_blocks_impl, impl, __ATOMIC_RELAXED);
+  }
+#else
+  sha256_blocks_fn impl = ur_bundled_sha256_blocks_impl;
+  if (!impl) {
+    impl = ur_bundled_sha256_select();
+    ur_bundled_sha256_blocks_impl = impl;
+  }
+#endif
+  return impl;
+}
+
+static void ur_bundled_sha256_blocks(WORD state[8], const BYTE *data,
+                                     size_t blocks) {
+  ur_bundled_sha256_backend()(state, data, blocks);
+}
+
+// Since this implementation uses little endian byte ordering and SHA uses big
+// endian, reverse all the bytes when copying the final state to the output
+// hash.
+static void ur_bundled_sha256_store(const WORD state[8], BYTE hash[]) {
+  WORD i;
+
+  for (i = 0; i < 4; ++i) {
+    hash[i] = (state[0] >> (24 - i * 8)) & 0x000000ff;
+    hash[i + 4] = (state[1] >> (24 - i * 8)) & 0x000000ff;
+    hash[i + 8] = (state[2] >> (24 - i * 8)) & 0x000000ff;
+    hash[i + 12] = (state[3] >> (24 - i * 8)) & 0x000000ff;
+    hash[i + 16] = (state[4] >> (24 - i * 8)) & 0x000000ff;
+    hash[i + 20] = (state[5] >> (24 - i * 8)) & 0x000000ff;
+    hash[i + 24] = (state[6] >> (24 - i * 8)) & 0x000000ff;
+    hash[i + 28] = (state[7] >> (24 - i * 8)) & 0x000000ff;
+  }
 }
 
 void ur_bundled_sha256_init(CRYAL_SHA256_CTX *ctx) {
@@ -100,17 +342,37 @@ void ur_bundled_sha256_init(CRYAL_SHA256_CTX *ctx) {
 
 void ur_bundled_sha256_update(CRYAL_SHA256_CTX *ctx, const BYTE data[],
                               size_t len) {
-  WORD i;
+  // Top up a partially filled buffer first, then compress whole blocks
+  // straight from the input and buffer only the tail.
+  if (len == 0)
+    return;
 
-  for (i = 0; i < len; ++i) {
-    ctx->data[ctx->datalen] = data[i];
-    ctx->datalen++;
-    if (ctx->datalen == 64) {
-      ur_bundled_sha256_transform(ctx, ctx->data);
-      ctx->bitlen += 512;
-      ctx->datalen = 0;
-    }
+  if (ctx->datalen > 0) {
+    size_t fill = 64 - ctx->datalen;
+    if (fill > len)
+      fill = len;
+    memcpy(ctx->data + ctx->datalen, data, fill);
+    ctx->datalen += (WORD)fill;
+    data += fill;
+    len -= fill;
+    if (ctx->datalen < 64)
+      return;
+    ur_bundled_sha256_blocks(ctx->state, ctx->data, 1);
+    ctx->bitlen += 512;
+    ctx->datalen = 0;
   }
+
+  if (len >= 64) {
+    size_t blocks = len / 64;
+    ur_bundled_sha256_blocks(ctx->state, data, blocks);
+    ctx->bitlen += (unsigned long long)blocks * 512;
+    data += blocks * 64;
+    len -= blocks * 64;
+  }
+
+  if (len > 0)
+    memcpy(ctx->data, data, len);
+  ctx->datalen = (WORD)len;
 }
 
 void ur_bundled_sha256_final(CRYAL_SHA256_CTX *ctx, BYTE hash[]) {
@@ -127,7 +389,7 @@ void ur_bundled_sha256_final(CRYAL_SHA256_CTX *ctx, BYTE hash[]) {
     ctx->data[i++] = 0x80;
     while (i < 64)
       ctx->data[i++] = 0x00;
-    ur_bundled_sha256_transform(ctx, ctx->data);
+    ur_bundled_sha256_blocks(ctx->state, ctx->data, 1);
     memset(ctx->data, 0, 56);
   }
 
@@ -141,19 +403,24 @@ void ur_bundled_sha256_final(CRYAL_SHA256_CTX *ctx, BYTE hash[]) {
   ctx->data[58] = ctx->bitlen >> 40;
   ctx->data[57] = ctx->bitlen >> 48;
   ctx->data[56] = ctx->bitlen >> 56;
-  ur_bundled_sha256_transform(ctx, ctx->data);
+  ur_bundled_sha256_blocks(ctx->state, ctx->data, 1);
 
-  // Since this implementation uses little endian byte ordering and SHA uses big
-  // endian, reverse all the bytes when copying the final state to the output
-  // hash.
-  for (i = 0; i < 4; ++i) {
-    hash[i] = (ctx->state[0] >> (24 - i * 8)) & 0x000000ff;
-    hash[i + 4] = (ctx->state[1] >> (24 - i * 8)) & 0x000000ff;
-    hash[i + 8] = (ctx->state[2] >> (24 - i * 8)) & 0x000000ff;
-    hash[i + 12] = (ctx->state[3] >> (24 - i * 8)) & 0x000000ff;
-    hash[i + 16] = (ctx->state[4] >> (24 - i * 8)) & 0x000000ff;
-    hash[i + 20] = (ctx->state[5] >> (24 - i * 8)) & 0x000000ff;
-    hash[i + 24] = (ctx->state[6] >> (24 - i * 8)) & 0x000000ff;
-    hash[i + 28] = (ctx->state[7] >> (24 - i * 8)) & 0x000000ff;
+  ur_bundled_sha256_store(ctx->state, hash);
+}
+
+void ur_bundled_sha256_8bytes(const BYTE input[8], BYTE hash[32]) {
+  sha256_blocks_fn impl = ur_bundled_sha256_backend();
+  if (impl == ur_bundled_sha256_blocks_portable) {
+    ur_sha256_8bytes_portable(input, hash);
+    return;
   }
+
+  CRYAL_SHA256_CTX ctx;
+  BYTE block[64] = {0};
+  memcpy(block, input, 8);
+  block[8] = 0x80;
+  block[63] = 64;
+  ur_bundled_sha256_init(&ctx);
+  impl(ctx.state, block, 1);
+  ur_bundled_sha256_store(ctx.state, hash);
 }
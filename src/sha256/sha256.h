@@ -10,6 +10,7 @@
 #define SHA256_H
 
 /*************************** HEADER FILES ***************************/
+#include "../ur_export.h"
 #include <stddef.h>
 
 /****************************** MACROS ******************************/
@@ -30,9 +31,14 @@ typedef struct {
 // Namespaced to avoid link-time collisions with platform SDKs that
 // export unprefixed sha256_init / sha256_update / sha256_final symbols
 // with different signatures (e.g. Kendryte K210 SDK, mbedTLS).
-void ur_bundled_sha256_init(CRYAL_SHA256_CTX *ctx);
-void ur_bundled_sha256_update(CRYAL_SHA256_CTX *ctx, const BYTE data[],
-                              size_t len);
-void ur_bundled_sha256_final(CRYAL_SHA256_CTX *ctx, BYTE hash[]);
+UR_INTERNAL void ur_bundled_sha256_init(CRYAL_SHA256_CTX *ctx);
+UR_INTERNAL void ur_bundled_sha256_update(CRYAL_SHA256_CTX *ctx,
+                                          const BYTE data[], size_t len);
+UR_INTERNAL void ur_bundled_sha256_final(CRYAL_SHA256_CTX *ctx, BYTE hash[]);
+
+// One-shot hash of exactly 8 bytes (fountain PRNG seeds). Runs a single
+// compression on the hardware backend when one is selected, else the
+// precomputed-padding portable path from sha256_8bytes.h.
+UR_INTERNAL void ur_bundled_sha256_8bytes(const BYTE input[8], BYTE hash[32]);
 
 #endif // SHA256_H
@@ -0,0 +1,92 @@
+#ifndef UR_SHA256_8BYTES_H
+#define UR_SHA256_8BYTES_H
+
+#include <stdint.h>
+
+// SHA-256 of exactly 8 bytes — the fountain PRNG seed (seq_num BE ||
+// checksum BE). The message fits in one block whose words W[2..15] are
+// fixed padding (0x80000000, eleven zero words, then the bit length 64),
+// so K[i] + W[i] for those rounds is folded into a table and there is no
+// context, buffering or length bookkeeping. Header-only so that every
+// backend can use it, including builds that do not compile sha256.c.
+
+static inline uint32_t ur_sha256_rotr(uint32_t x, unsigned int n) {
+  return (x >> n) | (x << (32 - n));
+}
+
+static inline void ur_sha256_8bytes_portable(const uint8_t input[8],
+                                             uint8_t output[32]) {
+  static const uint32_t k[64] = {
+      0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1,
+      0x923f82a4, 0xab1c5ed5, 0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+      0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174, 0xe49b69c1, 0xefbe4786,
+      0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+      0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147,
+      0x06ca6351, 0x14292967, 0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
+      0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85, 0xa2bfe8a1, 0xa81a664b,
+      0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+      0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a,
+      0x5b9cca4f, 0x682e6ff3, 0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+      0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2};
+  // K[i] + W[i] for the constant padding words, i = 2..15.
+  static const uint32_t kw_pad[14] = {
+      0x35c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4,
+      0xab1c5ed5, 0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+      0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf1b4};
+  static const uint32_t iv[8] = {0x6a09e667, 0xbb67ae85, 0x3c6ef372,
+                                 0xa54ff53a, 0x510e527f, 0x9b05688c,
+                                 0x1f83d9ab, 0x5be0cd19};
+  uint32_t w[16] = {0};
+  uint32_t a = iv[0], b = iv[1], c = iv[2], d = iv[3];
+  uint32_t e = iv[4], f = iv[5], g = iv[6], h = iv[7];
+
+  for (int i = 0; i < 2; i++)
+    w[i] = ((uint32_t)input[4 * i] << 24) | ((uint32_t)input[4 * i + 1] << 16) |
+           ((uint32_t)input[4 * i + 2] << 8) | (uint32_t)input[4 * i + 3];
+  w[2] = 0x80000000u;
+  w[15] = 64;
+
+  for (int i = 0; i < 64; i++) {
+    uint32_t wk;
+    if (i < 2) {
+      wk = k[i] + w[i];
+    } else if (i < 16) {
+      wk = kw_pad[i - 2];
+    } else {
+      uint32_t w2 = w[(i - 2) & 15];
+      uint32_t w15 = w[(i - 15) & 15];
+      w[i & 15] += (ur_sha256_rotr(w2, 17) ^ ur_sha256_rotr(w2, 19) ^
+                    (w2 >> 10)) +
+                   w[(i - 7) & 15] +
+                   (ur_sha256_rotr(w15, 7) ^ ur_sha256_rotr(w15, 18) ^
+                    (w15 >> 3));
+      wk = k[i] + w[i & 15];
+    }
+    uint32_t t1 = h +
+                  (ur_sha256_rotr(e, 6) ^ ur_sha256_rotr(e, 11) ^
+                   ur_sha256_rotr(e, 25)) +
+                  ((e & f) ^ (~e & g)) + wk;
+    uint32_t t2 = (ur_sha256_rotr(a, 2) ^ ur_sha256_rotr(a, 13) ^
+                   ur_sha256_rotr(a, 22)) +
+                  ((a & b) ^ (a & c) ^ (b & c));
+    h = g;
+    g = f;
+    f = e;
+    e = d + t1;
+    d = c;
+    c = b;
+    b = a;
+    a = t1 + t2;
+  }
+
+  uint32_t state[8] = {iv[0] + a, iv[1] + b, iv[2] + c, iv[3] + d,
+                       iv[4] + e, iv[5] + f, iv[6] + g, iv[7] + h};
+  for (int i = 0; i < 8; i++) {
+    output[4 * i] = (uint8_t)(state[i] >> 24);
+    output[4 * i + 1] = (uint8_t)(state[i] >> 16);
+    output[4 * i + 2] = (uint8_t)(state[i] >> 8);
+    output[4 * i + 3] = (uint8_t)state[i];
+  }
+}
+
+#endif // UR_SHA256_8BYTES_H
@@ -6,10 +6,14 @@
 #include <stdint.h>
 #include <stdlib.h>
 
+#include "sha256_8bytes.h"
+
 // Pick a SHA256 backend based on a compile-time flag.
 //   UR_USE_MBEDTLS_SHA256 -> mbedTLS PSA hash (e.g. ESP-IDF)
 //   UR_USE_K210_SHA256    -> sha256_hard_calculate (Kendryte K210 SDK)
 // Otherwise, fall back to the bundled implementation in sha256/sha256.c.
+// Every backend also provides ur_sha256_8bytes(), the single-block path
+// used for fountain PRNG seeds.
 #if defined(UR_USE_MBEDTLS_SHA256)
 
 #include <psa/crypto.h>
@@ -35,6 +39,13 @@ static inline void ur_sha256(const uint8_t *input, size_t len,
   }
 }
 
+// Fountain seeds are hashed in software: for an 8-byte input the PSA call
+// overhead costs more than the single compression itself.
+static inline void ur_sha256_8bytes(const uint8_t input[8],
+                                    uint8_t output[32]) {
+  ur_sha256_8bytes_portable(input, output);
+}
+
 #elif defined(UR_USE_K210_SHA256)
 
 #include <sha256.h>
@@ -44,6 +55,11 @@ static inline void ur_sha256(const uint8_t *input, size_t len,
   sha256_hard_calculate(input, len, output);
 }
 
+static inline void ur_sha256_8bytes(const uint8_t input[8],
+                                    uint8_t output[32]) {
+  ur_sha256_8bytes_portable(input, output);
+}
+
 #else
 
 #include "sha256/sha256.h"
@@ -56,6 +72,11 @@ static inline void ur_sha256(const uint8_t *input, size_t len,
   ur_bundled_sha256_final(&ctx, output);
 }
 
+static inline void ur_sha256_8bytes(const uint8_t input[8],
+                                    uint8_t output[32]) {
+  ur_bundled_sha256_8bytes(input, output);
+}
+
 #endif
 
 #endif
@@ -1,6 +1,7 @@
 #ifndef URTYPES_BIP39_H
 #define URTYPES_BIP39_H
 
+#include "../ur_export.h"
 #include "registry.h"
 #include <stddef.h>
 #include <stdint.h>
@@ -16,23 +17,24 @@ typedef struct {
 } bip39_data_t;
 
 // BIP39 registry type
-extern registry_type_t BIP39_TYPE;
+UR_API extern registry_type_t BIP39_TYPE;
 
 // Create and destroy BIP39
-bip39_data_t *bip39_new(char **words, size_t word_count, const char *lang);
-void bip39_free(bip39_data_t *bip39);
+UR_API bip39_data_t *bip39_new(char **words, size_t word_count,
+                               const char *lang);
+UR_API void bip39_free(bip39_data_t *bip39);
 
 // Registry item interface for BIP39
-registry_item_t *bip39_to_registry_item(bip39_data_t *bip39);
-bip39_data_t *bip39_from_registry_item(registry_item_t *item);
+UR_API registry_item_t *bip39_to_registry_item(bip39_data_t *bip39);
+UR_API bip39_data_t *bip39_from_registry_item(registry_item_t *item);
 
 // CBOR conversion functions (decode only)
-registry_item_t *bip39_from_data_item(cbor_value_t *data_item);
+UR_API registry_item_t *bip39_from_data_item(cbor_value_t *data_item);
 
 // Convenience functions
-bip39_data_t *bip39_from_cbor(const uint8_t *cbor_data, size_t len);
+UR_API bip39_data_t *bip39_from_cbor(const uint8_t *cbor_data, size_t len);
 
 // Accessors
-char **bip39_get_words(bip39_data_t *bip39, size_t *out_count);
+UR_API char **bip39_get_words(bip39_data_t *bip39, size_t *out_count);
 
 #endif // URTYPES_BIP39_H
@@ -1,6 +1,7 @@
 #ifndef URTYPES_BYTE_BUFFER_H
 #define URTYPES_BYTE_BUFFER_H
 
+#include "../ur_export.h"
 #include "../utils.h" // Use root utils for memory management (safe_malloc, safe_realloc, safe_strdup)
 #include <stdbool.h>
 #include <stddef.h>
@@ -14,12 +15,13 @@ typedef struct {
   size_t capacity;
 } byte_buffer_t;
 
-byte_buffer_t *byte_buffer_new(void);
-byte_buffer_t *byte_buffer_new_with_capacity(size_t capacity);
-void byte_buffer_free(byte_buffer_t *buf);
-bool byte_buffer_append(byte_buffer_t *buf, const uint8_t *data, size_t len);
-uint8_t *byte_buffer_get_data(byte_buffer_t *buf);
-size_t byte_buffer_get_len(byte_buffer_t *buf);
+UR_API byte_buffer_t *byte_buffer_new(void);
+UR_API byte_buffer_t *byte_buffer_new_with_capacity(size_t capacity);
+UR_API void byte_buffer_free(byte_buffer_t *buf);
+UR_API bool byte_buffer_append(byte_buffer_t *buf, const uint8_t *data,
+                               size_t len);
+UR_API uint8_t *byte_buffer_get_data(byte_buffer_t *buf);
+UR_API size_t byte_buffer_get_len(byte_buffer_t *buf);
 
 // Inlined here so toolchains that don't enable LTO (notably the K210
 // MaixPy build) don't pay the call overhead on the CBOR hot path.
@@ -28,7 +30,7 @@ static inline bool byte_buffer_append_byte(byte_buffer_t *buf, uint8_t byte) {
 }
 
 // Base58 encoding utilities
-char *base58_encode(const uint8_t *data, size_t len);
-char *base58check_encode(const uint8_t *data, size_t len);
+UR_API char *base58_encode(const uint8_t *data, size_t len);
+UR_API char *base58check_encode(const uint8_t *data, size_t len);
 
 #endif // URTYPES_BYTE_BUFFER_H
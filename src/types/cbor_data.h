@@ -1,6 +1,7 @@
 #ifndef URTYPES_CBOR_DATA_H
 #define URTYPES_CBOR_DATA_H
 
+#include "../ur_export.h"
 #include "byte_buffer.h"
 #include <stdbool.h>
 #include <stdint.h>
@@ -47,33 +48,34 @@ struct cbor_value {
 };
 
 // CBOR value creation functions
-cbor_value_t *cbor_value_new_unsigned_int(uint64_t val);
-cbor_value_t *cbor_value_new_bytes(const uint8_t *data, size_t len);
-cbor_value_t *cbor_value_new_string(const char *str);
-cbor_value_t *cbor_value_new_array(void);
-cbor_value_t *cbor_value_new_map(void);
-cbor_value_t *cbor_value_new_tag(uint64_t tag, cbor_value_t *content);
-cbor_value_t *cbor_value_new_bool(bool val);
+UR_API cbor_value_t *cbor_value_new_unsigned_int(uint64_t val);
+UR_API cbor_value_t *cbor_value_new_bytes(const uint8_t *data, size_t len);
+UR_API cbor_value_t *cbor_value_new_string(const char *str);
+UR_API cbor_value_t *cbor_value_new_array(void);
+UR_API cbor_value_t *cbor_value_new_map(void);
+UR_API cbor_value_t *cbor_value_new_tag(uint64_t tag, cbor_value_t *content);
+UR_API cbor_value_t *cbor_value_new_bool(bool val);
 
 // CBOR value manipulation
-bool cbor_array_append(cbor_value_t *array, cbor_value_t *item);
-bool cbor_map_set(cbor_value_t *map, cbor_value_t *key, cbor_value_t *value);
-cbor_value_t *cbor_map_get(cbor_value_t *map, cbor_value_t *key);
-cbor_value_t *cbor_map_get_int(cbor_value_t *map, int64_t key);
+UR_API bool cbor_array_append(cbor_value_t *array, cbor_value_t *item);
+UR_API bool cbor_map_set(cbor_value_t *map, cbor_value_t *key,
+                         cbor_value_t *value);
+UR_API cbor_value_t *cbor_map_get(cbor_value_t *map, cbor_value_t *key);
+UR_API cbor_value_t *cbor_map_get_int(cbor_value_t *map, int64_t key);
 
 // CBOR value accessors
-cbor_type_t cbor_value_get_type(cbor_value_t *val);
-uint64_t cbor_value_get_uint(cbor_value_t *val);
-const uint8_t *cbor_value_get_bytes(cbor_value_t *val, size_t *out_len);
-const char *cbor_value_get_string(cbor_value_t *val);
-size_t cbor_value_get_array_size(cbor_value_t *val);
-cbor_value_t *cbor_value_get_array_item(cbor_value_t *val, size_t index);
-bool cbor_value_get_bool(cbor_value_t *val);
-uint64_t cbor_value_get_tag(cbor_value_t *val);
-cbor_value_t *cbor_value_get_tag_content(cbor_value_t *val);
+UR_API cbor_type_t cbor_value_get_type(cbor_value_t *val);
+UR_API uint64_t cbor_value_get_uint(cbor_value_t *val);
+UR_API const uint8_t *cbor_value_get_bytes(cbor_value_t *val, size_t *out_len);
+UR_API const char *cbor_value_get_string(cbor_value_t *val);
+UR_API size_t cbor_value_get_array_size(cbor_value_t *val);
+UR_API cbor_value_t *cbor_value_get_array_item(cbor_value_t *val, size_t index);
+UR_API bool cbor_value_get_bool(cbor_value_t *val);
+UR_API uint64_t cbor_value_get_tag(cbor_value_t *val);
+UR_API cbor_value_t *cbor_value_get_tag_content(cbor_value_t *val);
 
 // CBOR value cleanup
-void cbor_value_free(cbor_value_t *val);
+UR_API void cbor_value_free(cbor_value_t *val);
 
 // Data item (tagged CBOR value) - convenience type
 typedef cbor_value_t cbor_data_item_t;
@@ -1,6 +1,7 @@
 #ifndef URTYPES_CBOR_ENCODER_H
 #define URTYPES_CBOR_ENCODER_H
 
+#include "../ur_export.h"
 #include "byte_buffer.h"
 #include "cbor_data.h"
 #include <stddef.h>
@@ -12,16 +13,16 @@ typedef struct {
 } urtypes_cbor_encoder_t;
 
 // Create and destroy encoder
-urtypes_cbor_encoder_t *urtypes_cbor_encoder_new(void);
-void urtypes_cbor_encoder_free(urtypes_cbor_encoder_t *encoder);
+UR_API urtypes_cbor_encoder_t *urtypes_cbor_encoder_new(void);
+UR_API void urtypes_cbor_encoder_free(urtypes_cbor_encoder_t *encoder);
 
 // Encode CBOR value
-bool urtypes_cbor_encoder_encode(urtypes_cbor_encoder_t *encoder,
-                                 cbor_value_t *value);
+UR_API bool urtypes_cbor_encoder_encode(urtypes_cbor_encoder_t *encoder,
+                                        cbor_value_t *value);
 
 // Get encoded data
-uint8_t *urtypes_cbor_encoder_get_data(urtypes_cbor_encoder_t *encoder,
-                                       size_t *out_len);
+UR_API uint8_t *urtypes_cbor_encoder_get_data(urtypes_cbor_encoder_t *encoder,
+                                              size_t *out_len);
 
 // Wrapper macros
 #define cbor_encoder_t urtypes_cbor_encoder_t
@@ -31,6 +32,6 @@ uint8_t *urtypes_cbor_encoder_get_data(urtypes_cbor_encoder_t *encoder,
 #define cbor_encoder_get_data urtypes_cbor_encoder_get_data
 
 // Convenience function to encode a value to bytes
-uint8_t *cbor_encode(cbor_value_t *value, size_t *out_len);
+UR_API uint8_t *cbor_encode(cbor_value_t *value, size_t *out_len);
 
 #endif // URTYPES_CBOR_ENCODER_H
@@ -1,6 +1,7 @@
 #ifndef URTYPES_KEYPATH_H
 #define URTYPES_KEYPATH_H
 
+#include "../ur_export.h"
 #include "registry.h"
 #include <stdbool.h>
 #include <stddef.h>
@@ -25,23 +26,24 @@ typedef struct {
 } keypath_data_t;
 
 // Keypath registry type
-extern registry_type_t KEYPATH_TYPE;
+UR_API extern registry_type_t KEYPATH_TYPE;
 
 // Create and destroy Keypath
-keypath_data_t *keypath_new(path_component_t *components,
-                            size_t component_count,
-                            const uint8_t *source_fingerprint, int depth);
-void keypath_free(keypath_data_t *keypath);
+UR_API keypath_data_t *keypath_new(path_component_t *components,
+                                   size_t component_count,
+                                   const uint8_t *source_fingerprint,
+                                   int depth);
+UR_API void keypath_free(keypath_data_t *keypath);
 
 // Registry item interface for Keypath
-registry_item_t *keypath_to_registry_item(keypath_data_t *keypath);
-keypath_data_t *keypath_from_registry_item(registry_item_t *item);
+UR_API registry_item_t *keypath_to_registry_item(keypath_data_t *keypath);
+UR_API keypath_data_t *keypath_from_registry_item(registry_item_t *item);
 
 // CBOR conversion functions
-registry_item_t *keypath_from_data_item(cbor_value_t *data_item);
-cbor_value_t *keypath_to_data_item(keypath_data_t *keypath);
+UR_API registry_item_t *keypath_from_data_item(cbor_value_t *data_item);
+UR_API cbor_value_t *keypath_to_data_item(keypath_data_t *keypath);
 
 // Helper to generate path string (e.g., "44'/0'/0'", "1/0/*")
-char *keypath_to_string(keypath_data_t *keypath);
+UR_API char *keypath_to_string(keypath_data_t *keypath);
 
 #endif // URTYPES_KEYPATH_H
@@ -1,6 +1,7 @@
 #ifndef URTYPES_MULTI_KEY_H
 #define URTYPES_MULTI_KEY_H
 
+#include "../ur_export.h"
 #include "hd_key.h"
 #include "registry.h"
 #include <stddef.h>
@@ -15,14 +16,15 @@ typedef struct {
 } multi_key_data_t;
 
 // Create and destroy MultiKey
-multi_key_data_t *multi_key_new(uint32_t threshold);
-void multi_key_free(multi_key_data_t *multi_key);
+UR_API multi_key_data_t *multi_key_new(uint32_t threshold);
+UR_API void multi_key_free(multi_key_data_t *multi_key);
 
 // CBOR conversion functions
-multi_key_data_t *multi_key_from_data_item(cbor_value_t *data_item);
-cbor_value_t *multi_key_to_data_item(multi_key_data_t *multi_key);
+UR_API multi_key_data_t *multi_key_from_data_item(cbor_value_t *data_item);
+UR_API cbor_value_t *multi_key_to_data_item(multi_key_data_t *multi_key);
 
 // Add keys to MultiKey
-bool multi_key_add_hd_key(multi_key_data_t *multi_key, hd_key_data_t *hd_key);
+UR_API bool multi_key_add_hd_key(multi_key_data_t *multi_key,
+                                 hd_key_data_t *hd_key);
 
 #endif // URTYPES_MULTI_KEY_H
@@ -1,6 +1,7 @@
 #ifndef URTYPES_OUTPUT_H
 #define URTYPES_OUTPUT_H
 
+#include "../ur_export.h"
 #include "hd_key.h"
 #include "multi_key.h"
 #include "registry.h"
@@ -49,33 +50,33 @@ typedef struct {
 } output_data_t;
 
 // Output registry type
-extern registry_type_t OUTPUT_TYPE;
+UR_API extern registry_type_t OUTPUT_TYPE;
 
 // Create and destroy Output
-output_data_t *output_new(void);
-void output_free(output_data_t *output);
+UR_API output_data_t *output_new(void);
+UR_API void output_free(output_data_t *output);
 
 // Registry item interface for Output
-registry_item_t *output_to_registry_item(output_data_t *output);
-output_data_t *output_from_registry_item(registry_item_t *item);
+UR_API registry_item_t *output_to_registry_item(output_data_t *output);
+UR_API output_data_t *output_from_registry_item(registry_item_t *item);
 
 // CBOR conversion functions
-registry_item_t *output_from_data_item(cbor_value_t *data_item);
-output_data_t *output_from_cbor(const uint8_t *cbor_data, size_t len);
-cbor_value_t *output_to_data_item(output_data_t *output);
-uint8_t *output_to_cbor(output_data_t *output, size_t *out_len);
+UR_API registry_item_t *output_from_data_item(cbor_value_t *data_item);
+UR_API output_data_t *output_from_cbor(const uint8_t *cbor_data, size_t len);
+UR_API cbor_value_t *output_to_data_item(output_data_t *output);
+UR_API uint8_t *output_to_cbor(output_data_t *output, size_t *out_len);
 
 // Parse descriptor string into output_data_t
-output_data_t *output_from_descriptor_string(const char *descriptor);
+UR_API output_data_t *output_from_descriptor_string(const char *descriptor);
 
 // Generate output descriptor string
-char *output_descriptor(output_data_t *output, bool include_checksum);
+UR_API char *output_descriptor(output_data_t *output, bool include_checksum);
 
 // Helper function to extract first output descriptor from Account CBOR
-char *output_descriptor_from_cbor_account(const uint8_t *account_cbor,
-                                          size_t len);
+UR_API char *output_descriptor_from_cbor_account(const uint8_t *account_cbor,
+                                                 size_t len);
 
 // Script expression helpers
-const script_expression_t *get_script_expression_by_tag(uint64_t tag);
+UR_API const script_expression_t *get_script_expression_by_tag(uint64_t tag);
 
 #endif // URTYPES_OUTPUT_H
@@ -0,0 +1,149 @@
+#include "payload_check.h"
+#include "output.h"
+#include <string.h>
+
+#define CBOR_MAJOR_UINT 0
+#define CBOR_MAJOR_BYTES 2
+#define CBOR_MAJOR_ARRAY 4
+#define CBOR_MAJOR_MAP 5
+#define CBOR_MAJOR_TAG 6
+
+static const uint8_t PSBT_MAGIC[] = {'p', 's', 'b', 't', 0xff};
+
+// Read the CBOR head at data: its major type and, for a definite argument,
+// the argument. Returns the head length, or 0 when the argument is not
+// known (data ends inside the head, or an indefinite/reserved length).
+// *major is set whenever len > 0.
+static size_t payload_read_head(const uint8_t *data, size_t len,
+                                uint8_t *major, uint64_t *arg) {
+  if (len == 0)
+    return 0;
+  *major = data[0] >> 5;
+
+  uint8_t additional = data[0] & 0x1f;
+  if (additional < 24) {
+    *arg = additional;
+    return 1;
+  }
+  if (additional > 27)
+    return 0;
+
+  size_t head_len = 1 + ((size_t)1 << (additional - 24));
+  if (head_len > len)
+    return 0;
+  *arg = 0;
+  for (size_t i = 1; i < head_len; i++) {
+    *arg = (*arg << 8) | data[i];
+  }
+  return head_len;
+}
+
+// A map whose first key is 1, followed by a value of value_major
+static bool payload_map_key1(const uint8_t *data, size_t len,
+                             uint8_t value_major, uint64_t min_entries) {
+  uint8_t major;
+  uint64_t entries = 0;
+  size_t head_len = payload_read_head(data, len, &major, &entries);
+  if (len == 0)
+    return true;
+  if (major != CBOR_MAJOR_MAP)
+    return false;
+  if (head_len == 0)
+    return true;
+  if (entries < min_entries)
+    return false;
+
+  data += head_len;
+  len -= head_len;
+  if (len == 0)
+    return true;
+  if (data[0] != 0x01) // unsigned integer 1
+    return false;
+  return len < 2 || (data[1] >> 5) == value_major;
+}
+
+bool bytes_payload_check(void *ctx, const char *type, const uint8_t *data,
+                         size_t len, size_t message_len) {
+  (void)ctx;
+  (void)type;
+  uint8_t major;
+  uint64_t content_len = 0;
+  size_t head_len = payload_read_head(data, len, &major, &content_len);
+  if (len == 0)
+    return true;
+  if (major != CBOR_MAJOR_BYTES)
+    return false;
+  return head_len == 0 || content_len == message_len - head_len;
+}
+
+bool psbt_payload_check(void *ctx, const char *type, const uint8_t *data,
+                        size_t len, size_t message_len) {
+  if (!bytes_payload_check(ctx, type, data, len, message_len))
+    return false;
+
+  uint8_t major;
+  uint64_t content_len;
+  size_t head_len = payload_read_head(data, len, &major, &content_len);
+  if (head_len == 0)
+    return true;
+
+  // Compare as much of the magic as has arrived
+  size_t available = len - head_len;
+  if (available > sizeof(PSBT_MAGIC))
+    available = sizeof(PSBT_MAGIC);
+  return memcmp(data + head_len, PSBT_MAGIC, available) == 0;
+}
+
+bool output_payload_check(void *ctx, const char *type, const uint8_t *data,
+                          size_t len, size_t message_len) {
+  (void)ctx;
+  (void)type;
+  (void)message_len;
+  uint8_t major;
+  uint64_t tag = 0;
+  size_t head_len = payload_read_head(data, len, &major, &tag);
+  if (len == 0)
+    return true;
+  if (major != CBOR_MAJOR_TAG)
+    return false;
+  return head_len == 0 || tag == CRYPTO_OUTPUT_TAG ||
+         get_script_expression_by_tag(tag) != NULL;
+}
+
+bool account_payload_check(void *ctx, const char *type, const uint8_t *data,
+                           size_t len, size_t message_len) {
+  (void)ctx;
+  (void)type;
+  (void)message_len;
+  return payload_map_key1(data, len, CBOR_MAJOR_UINT, 2);
+}
+
+bool bip39_payload_check(void *ctx, const char *type, const uint8_t *data,
+                         size_t len, size_t message_len) {
+  (void)ctx;
+  (void)type;
+  (void)message_len;
+  return payload_map_key1(data, len, CBOR_MAJOR_ARRAY, 1);
+}
+
+bool registry_payload_check(void *ctx, const char *type, const uint8_t *data,
+                            size_t len, size_t message_len) {
+  static const struct {
+    const char *type;
+    bool (*check)(void *, const char *, const uint8_t *, size_t, size_t);
+  } checks[] = {
+      {"bytes", bytes_payload_check},
+      {"crypto-psbt", psbt_payload_check},
+      {"crypto-output", output_payload_check},
+      {"crypto-account", account_payload_check},
+      {"crypto-bip39", bip39_payload_check},
+  };
+
+  if (!type)
+    return true;
+  for (size_t i = 0; i < sizeof(checks) / sizeof(checks[0]); i++) {
+    if (strcmp(type, checks[i].type) == 0)
+      return checks[i].check(ctx, type, data, len, message_len);
+  }
+  return true;
+}
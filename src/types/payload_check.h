@@ -0,0 +1,97 @@
+#ifndef URTYPES_PAYLOAD_CHECK_H
+#define URTYPES_PAYLOAD_CHECK_H
+
+#include "../ur_export.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Payload predicates for ur_decoder_set_payload_check(). Each sees only the
+// leading len bytes of the CBOR payload (usually fragment 0) and the full
+// payload length, and returns false only when those bytes already rule out
+// the type; a payload too short to judge is accepted. ctx and type are
+// unused except by registry_payload_check().
+
+/**
+ * bytes: a definite-length byte string spanning the whole payload
+ * @param ctx Unused
+ * @param type UR type (unused)
+ * @param data Leading payload bytes
+ * @param len Number of bytes in data
+ * @param message_len Full payload length
+ * @return false if the payload cannot be a bytes item
+ */
+UR_API bool bytes_payload_check(void *ctx, const char *type,
+                                const uint8_t *data, size_t len,
+                                size_t message_len);
+
+/**
+ * crypto-psbt: a bytes item whose content starts with the PSBT magic
+ * ("psbt" 0xff)
+ * @param ctx Unused
+ * @param type UR type (unused)
+ * @param data Leading payload bytes
+ * @param len Number of bytes in data
+ * @param message_len Full payload length
+ * @return false if the payload cannot be a PSBT
+ */
+UR_API bool psbt_payload_check(void *ctx, const char *type,
+                               const uint8_t *data, size_t len,
+                               size_t message_len);
+
+/**
+ * crypto-output: a script expression tag (307, 400-410) or an output tag
+ * (308)
+ * @param ctx Unused
+ * @param type UR type (unused)
+ * @param data Leading payload bytes
+ * @param len Number of bytes in data
+ * @param message_len Full payload length
+ * @return false if the payload cannot be an output descriptor
+ */
+UR_API bool output_payload_check(void *ctx, const char *type,
+                                 const uint8_t *data, size_t len,
+                                 size_t message_len);
+
+/**
+ * crypto-account: a map of at least two entries, the first being key 1
+ * (the master fingerprint, an unsigned integer)
+ * @param ctx Unused
+ * @param type UR type (unused)
+ * @param data Leading payload bytes
+ * @param len Number of bytes in data
+ * @param message_len Full payload length
+ * @return false if the payload cannot be an account
+ */
+UR_API bool account_payload_check(void *ctx, const char *type,
+                                  const uint8_t *data, size_t len,
+                                  size_t message_len);
+
+/**
+ * crypto-bip39: a map whose first entry is key 1 (the word array)
+ * @param ctx Unused
+ * @param type UR type (unused)
+ * @param data Leading payload bytes
+ * @param len Number of bytes in data
+ * @param message_len Full payload length
+ * @return false if the payload cannot be a BIP39 mnemonic
+ */
+UR_API bool bip39_payload_check(void *ctx, const char *type,
+                                const uint8_t *data, size_t len,
+                                size_t message_len);
+
+/**
+ * Dispatch on the UR type to the predicate above for it; payloads of
+ * other types are accepted
+ * @param ctx Unused
+ * @param type UR type of the message
+ * @param data Leading payload bytes
+ * @param len Number of bytes in data
+ * @param message_len Full payload length
+ * @return false if the payload cannot be of the given registry type
+ */
+UR_API bool registry_payload_check(void *ctx, const char *type,
+                                   const uint8_t *data, size_t len,
+                                   size_t message_len);
+
+#endif // URTYPES_PAYLOAD_CHECK_H
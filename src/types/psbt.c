@@ -113,10 +113,18 @@ static bool read_cbor_byte_string(const uint8_t *cbor_data, size_t len,
   return true;
 }
 
-psbt_data_t *psbt_from_cbor(const uint8_t *cbor_data, size_t len) {
+const uint8_t *psbt_payload_from_cbor(const uint8_t *cbor_data, size_t len,
+                                      size_t *out_len) {
   const uint8_t *data = NULL;
+  if (!read_cbor_byte_string(cbor_data, len, &data, out_len))
+    return NULL;
+  return data;
+}
+
+psbt_data_t *psbt_from_cbor(const uint8_t *cbor_data, size_t len) {
   size_t data_len = 0;
-  if (!read_cbor_byte_string(cbor_data, len, &data, &data_len))
+  const uint8_t *data = psbt_payload_from_cbor(cbor_data, len, &data_len);
+  if (!data)
     return NULL;
 
   return psbt_new(data, data_len);
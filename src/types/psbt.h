@@ -1,6 +1,7 @@
 #ifndef URTYPES_PSBT_H
 #define URTYPES_PSBT_H
 
+#include "../ur_export.h"
 #include "bytes_type.h"
 #include "registry.h"
 #include <stddef.h>
@@ -13,25 +14,35 @@
 typedef bytes_data_t psbt_data_t;
 
 // PSBT registry type
-extern registry_type_t PSBT_TYPE;
+UR_API extern registry_type_t PSBT_TYPE;
 
 // Create and destroy PSBT
-psbt_data_t *psbt_new(const uint8_t *data, size_t len);
-void psbt_free(psbt_data_t *psbt);
+UR_API psbt_data_t *psbt_new(const uint8_t *data, size_t len);
+UR_API void psbt_free(psbt_data_t *psbt);
 
 // Registry item interface for PSBT
-registry_item_t *psbt_to_registry_item(psbt_data_t *psbt);
-psbt_data_t *psbt_from_registry_item(registry_item_t *item);
+UR_API registry_item_t *psbt_to_registry_item(psbt_data_t *psbt);
+UR_API psbt_data_t *psbt_from_registry_item(registry_item_t *item);
 
 // CBOR conversion functions
-cbor_value_t *psbt_to_data_item(registry_item_t *item);
-registry_item_t *psbt_from_data_item(cbor_value_t *data_item);
+UR_API cbor_value_t *psbt_to_data_item(registry_item_t *item);
+UR_API registry_item_t *psbt_from_data_item(cbor_value_t *data_item);
 
 // Convenience functions
-uint8_t *psbt_to_cbor(psbt_data_t *psbt, size_t *out_len);
-psbt_data_t *psbt_from_cbor(const uint8_t *cbor_data, size_t len);
+UR_API uint8_t *psbt_to_cbor(psbt_data_t *psbt, size_t *out_len);
+UR_API psbt_data_t *psbt_from_cbor(const uint8_t *cbor_data, size_t len);
+
+/**
+ * Locate the PSBT payload inside its CBOR encoding without copying.
+ * @param cbor_data CBOR-encoded PSBT (a definite-length byte string)
+ * @param len Length of cbor_data
+ * @param out_len Output payload length
+ * @return Pointer into cbor_data at the payload, or NULL if malformed
+ */
+UR_API const uint8_t *psbt_payload_from_cbor(const uint8_t *cbor_data,
+                                             size_t len, size_t *out_len);
 
 // Accessors
-const uint8_t *psbt_get_data(psbt_data_t *psbt, size_t *out_len);
+UR_API const uint8_t *psbt_get_data(psbt_data_t *psbt, size_t *out_len);
 
 #endif // URTYPES_PSBT_H
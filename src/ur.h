@@ -1,6 +1,7 @@
 #ifndef UR_H
 #define UR_H
 
+#include "ur_export.h"
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
@@ -18,34 +19,34 @@ typedef struct {
  * @param cbor_len Length of CBOR data
  * @return Pointer to UR object or NULL on error
  */
-ur_t *ur_new(const char *type, const uint8_t *cbor, size_t cbor_len);
+UR_API ur_t *ur_new(const char *type, const uint8_t *cbor, size_t cbor_len);
 
 /**
  * Free UR object
  * @param ur Pointer to UR object
  */
-void ur_free(ur_t *ur);
+UR_API void ur_free(ur_t *ur);
 
 /**
  * Get UR type
  * @param ur Pointer to UR object
  * @return Type string (do not free)
  */
-const char *ur_get_type(const ur_t *ur);
+UR_API const char *ur_get_type(const ur_t *ur);
 
 /**
  * Get UR CBOR data
  * @param ur Pointer to UR object
  * @return CBOR data pointer (do not free)
  */
-const uint8_t *ur_get_cbor(const ur_t *ur);
+UR_API const uint8_t *ur_get_cbor(const ur_t *ur);
 
 /**
  * Get UR CBOR data length
  * @param ur Pointer to UR object
  * @return CBOR data length
  */
-size_t ur_get_cbor_len(const ur_t *ur);
+UR_API size_t ur_get_cbor_len(const ur_t *ur);
 
 /**
  * Create UR from ur_result_t (convenience function)
@@ -54,6 +55,6 @@ size_t ur_get_cbor_len(const ur_t *ur);
  * @return Pointer to UR object or NULL on error
  */
 struct ur_result;
-ur_t *ur_from_result(const struct ur_result *result);
+UR_API ur_t *ur_from_result(const struct ur_result *result);
 
 #endif // UR_H
\ No newline at end of file
@@ -12,9 +12,12 @@
 //
 
 #include "ur_decoder.h"
+#include "ur_decoder_internal.h"
 #include "bytewords.h"
 #include "fountain_decoder.h"
+#include "fountain_utils.h"
 #include "utils.h"
+#include "xor_internal.h"
 #include <stdlib.h>
 #include <string.h>
 
@@ -31,6 +34,21 @@
 #ifndef UR_MAX_MESSAGE_LEN
 #define UR_MAX_MESSAGE_LEN (256u * 1024u)
 #endif
+#if UR_MAX_SEQ_LEN > UR_INDEX_MAX
+#error "UR_MAX_SEQ_LEN exceeds UR_INDEX_MAX; build with UR_INDEX_BITS=32"
+#endif
+
+// seq_len cap for a decoder whose message cap is max_message_len (set with
+// an output sink): a raised message cap raises it in proportion, keeping
+// the defaults' ratio, up to the fountain index limit.
+static size_t max_seq_len_for(size_t max_message_len) {
+  size_t scale = max_message_len / UR_MAX_MESSAGE_LEN;
+  if (scale <= 1)
+    return UR_MAX_SEQ_LEN;
+  if (scale > UR_INDEX_MAX / UR_MAX_SEQ_LEN)
+    return UR_INDEX_MAX;
+  return UR_MAX_SEQ_LEN * scale;
+}
 
 static fountain_encoder_part_t *
 create_fountain_part_from_cbor(uint8_t *cbor_data, size_t cbor_len,
@@ -63,7 +81,7 @@ create_fountain_part_from_cbor(uint8_t *cbor_data, size_t cbor_len,
   return part;
 }
 
-static void free_fountain_part(fountain_encoder_part_t *part) {
+void ur_decoder_free_fountain_part(fountain_encoder_part_t *part) {
   if (part) {
     if (part->data) {
       free(part->data);
@@ -86,6 +104,15 @@ ur_decoder_t *ur_decoder_new(void) {
   decoder->expected_type = NULL;
   decoder->result = NULL;
   decoder->state = UR_DECODER_PROCESSING;
+  decoder->max_message_len = 0;
+  decoder->output_sink = false;
+  decoder->prefix_fn = NULL;
+  decoder->prefix_ctx = NULL;
+  decoder->payload_check = NULL;
+  decoder->payload_check_ctx = NULL;
+  decoder->payload_rejected = false;
+  decoder->cache = NULL;
+  decoder->cache_checksum = 0;
 
   return decoder;
 }
@@ -109,29 +136,305 @@ void ur_decoder_free(ur_decoder_t *decoder) {
   free(decoder);
 }
 
-static bool validate_part_type(ur_decoder_t *decoder, const char *type) {
-  if (!decoder || !type)
+void ur_decoder_reset(ur_decoder_t *decoder, size_t shrink_threshold) {
+  if (!decoder)
+    return;
+
+  fountain_decoder_reset(decoder->fountain_decoder, shrink_threshold);
+  safe_free(decoder->expected_type);
+  if (decoder->result) {
+    ur_result_free(decoder->result);
+    decoder->result = NULL;
+  }
+  decoder->state = UR_DECODER_PROCESSING;
+  decoder->max_message_len = 0;
+  decoder->output_sink = false;
+  decoder->prefix_fn = NULL;
+  decoder->prefix_ctx = NULL;
+  decoder->payload_check = NULL;
+  decoder->payload_check_ctx = NULL;
+  decoder->payload_rejected = false;
+  decoder->cache_checksum = 0;
+}
+
+bool ur_decoder_set_output_sink(ur_decoder_t *decoder,
+                                const fountain_sink_t *sink,
+                                size_t max_message_len) {
+  if (!sink)
+    return false;
+  if (!decoder || decoder->expected_type ||
+      ur_decoder_state_is_terminal(decoder->state)) {
+    if (sink->close) {
+      sink->close(sink->ctx);
+    }
+    return false;
+  }
+  if (!fountain_decoder_set_sink(decoder->fountain_decoder, sink))
+    return false;
+
+  decoder->max_message_len = max_message_len;
+  decoder->output_sink = true;
+  return true;
+}
+
+// Run the payload check (if any) on the leading payload bytes; a rejection
+// is recorded for the caller to turn into UR_DECODER_ERROR_INVALID_PAYLOAD
+static bool payload_accepted(ur_decoder_t *decoder, const uint8_t *data,
+                             size_t len, size_t message_len) {
+  if (decoder->payload_check &&
+      !decoder->payload_check(decoder->payload_check_ctx,
+                              decoder->expected_type, data, len,
+                              message_len)) {
+    decoder->payload_rejected = true;
+  }
+  return !decoder->payload_rejected;
+}
+
+// Fountain prefix callback: the first chunk (fragment 0) goes through the
+// payload check, then every chunk on to the caller's prefix callback
+static void on_fountain_prefix(void *ctx, size_t offset, const uint8_t *data,
+                               size_t len) {
+  ur_decoder_t *decoder = (ur_decoder_t *)ctx;
+  if (offset == 0) {
+    fountain_decoder_stats_t stats;
+    fountain_decoder_get_stats(decoder->fountain_decoder, &stats);
+    payload_accepted(decoder, data, len, stats.message_len);
+  }
+  if (!decoder->payload_rejected && decoder->prefix_fn) {
+    decoder->prefix_fn(decoder->prefix_ctx, offset, data, len);
+  }
+}
+
+static void update_prefix_hook(ur_decoder_t *decoder) {
+  bool hook = decoder->prefix_fn || decoder->payload_check;
+  fountain_decoder_set_prefix_callback(decoder->fountain_decoder,
+                                       hook ? on_fountain_prefix : NULL,
+                                       decoder);
+}
+
+void ur_decoder_set_prefix_callback(ur_decoder_t *decoder,
+                                    fountain_prefix_fn fn, void *ctx) {
+  if (!decoder)
+    return;
+  decoder->prefix_fn = fn;
+  decoder->prefix_ctx = ctx;
+  update_prefix_hook(decoder);
+}
+
+bool ur_decoder_set_payload_check(ur_decoder_t *decoder,
+                                  ur_payload_check_fn fn, void *ctx) {
+  if (!decoder || decoder->expected_type ||
+      ur_decoder_state_is_terminal(decoder->state))
     return false;
+  decoder->payload_check = fn;
+  decoder->payload_check_ctx = ctx;
+  update_prefix_hook(decoder);
+  return true;
+}
 
-  if (!decoder->expected_type) {
+// Recently decoded messages. The entry array is allocated once at
+// max_entries; last_used (a tick of clock) picks the LRU victim.
+typedef struct {
+  char *type;
+  size_t seq_len;
+  uint32_t checksum;
+  uint8_t *cbor_data;
+  size_t cbor_len;
+  uint64_t last_used;
+} cache_entry_t;
+
+struct ur_decoder_cache {
+  cache_entry_t *entries;
+  size_t count;
+  size_t max_entries;
+  size_t bytes; // cbor_len summed over the entries
+  size_t max_bytes;
+  uint64_t clock;
+};
+
+ur_decoder_cache_t *ur_decoder_cache_new(size_t max_entries,
+                                         size_t max_bytes) {
+  if (max_entries == 0 || max_entries > SIZE_MAX / sizeof(cache_entry_t))
+    return NULL;
+
+  ur_decoder_cache_t *cache = safe_malloc(sizeof(ur_decoder_cache_t));
+  if (!cache)
+    return NULL;
+  cache->entries = safe_malloc(max_entries * sizeof(cache_entry_t));
+  if (!cache->entries) {
+    free(cache);
+    return NULL;
+  }
+  cache->count = 0;
+  cache->max_entries = max_entries;
+  cache->bytes = 0;
+  cache->max_bytes = max_bytes;
+  cache->clock = 0;
+  return cache;
+}
+
+// Free entry i and move the last entry into its slot
+static void cache_remove(ur_decoder_cache_t *cache, size_t i) {
+  cache_entry_t *entry = &cache->entries[i];
+  free(entry->type);
+  free(entry->cbor_data);
+  cache->bytes -= entry->cbor_len;
+  *entry = cache->entries[--cache->count];
+}
+
+void ur_decoder_cache_clear(ur_decoder_cache_t *cache) {
+  if (!cache)
+    return;
+  while (cache->count > 0) {
+    cache_remove(cache, cache->count - 1);
+  }
+}
+
+void ur_decoder_cache_free(ur_decoder_cache_t *cache) {
+  if (!cache)
+    return;
+  ur_decoder_cache_clear(cache);
+  free(cache->entries);
+  free(cache);
+}
+
+// Index of the entry with this key, or cache->count if there is none
+static size_t cache_find(const ur_decoder_cache_t *cache, const char *type,
+                         size_t seq_len, size_t message_len,
+                         uint32_t checksum) {
+  for (size_t i = 0; i < cache->count; i++) {
+    const cache_entry_t *entry = &cache->entries[i];
+    if (entry->seq_len == seq_len && entry->cbor_len == message_len &&
+        entry->checksum == checksum && strcmp(entry->type, type) == 0)
+      return i;
+  }
+  return cache->count;
+}
+
+// Store a copy of a decoded message, evicting least recently used entries
+// to make room. Failure only means the message is not cached.
+static void cache_insert(ur_decoder_cache_t *cache, const char *type,
+                         size_t seq_len, uint32_t checksum,
+                         const uint8_t *cbor_data, size_t cbor_len) {
+  if (cbor_len > cache->max_bytes)
+    return;
+
+  size_t existing = cache_find(cache, type, seq_len, cbor_len, checksum);
+  if (existing < cache->count) {
+    cache_remove(cache, existing);
+  }
+  while (cache->count == cache->max_entries ||
+         cache->bytes + cbor_len > cache->max_bytes) {
+    size_t lru = 0;
+    for (size_t i = 1; i < cache->count; i++) {
+      if (cache->entries[i].last_used < cache->entries[lru].last_used)
+        lru = i;
+    }
+    cache_remove(cache, lru);
+  }
+
+  char *type_copy = safe_strdup(type);
+  uint8_t *data_copy = safe_malloc_uninit(cbor_len);
+  if (!type_copy || !data_copy) {
+    free(type_copy);
+    free(data_copy);
+    return;
+  }
+  memcpy(data_copy, cbor_data, cbor_len);
+
+  cache_entry_t *entry = &cache->entries[cache->count++];
+  entry->type = type_copy;
+  entry->seq_len = seq_len;
+  entry->checksum = checksum;
+  entry->cbor_data = data_copy;
+  entry->cbor_len = cbor_len;
+  entry->last_used = ++cache->clock;
+  cache->bytes += cbor_len;
+}
+
+// A key match is only a candidate: the frame must also have the message's
+// fragment length and carry exactly the XOR of the fragments its seq_num
+// selects from the cached message, so a checksum collision cannot
+// substitute a different payload.
+static bool cache_entry_matches(const cache_entry_t *entry,
+                                const fountain_encoder_part_t *part) {
+  size_t fragment_len = part->data_len;
+  if (fragment_len == 0 ||
+      (entry->cbor_len - 1) / fragment_len + 1 != entry->seq_len)
+    return false;
+
+  part_indexes_t indexes = {0};
+  uint8_t *mix = safe_malloc(fragment_len);
+  bool ok = mix && choose_fragments(part->seq_num, entry->seq_len,
+                                    entry->checksum, &indexes);
+  for (size_t k = 0; ok && k < indexes.count; k++) {
+    size_t offset = (size_t)indexes.indexes[k] * fragment_len;
+    size_t len = entry->cbor_len - offset < fragment_len
+                     ? entry->cbor_len - offset
+                     : fragment_len;
+    ur_xor_inplace(mix, entry->cbor_data + offset, len);
+  }
+  ok = ok && memcmp(mix, part->data, fragment_len) == 0;
+
+  free(mix);
+  free(indexes.indexes);
+  return ok;
+}
+
+// Copy of the cached message this first frame belongs to, or NULL
+static ur_result_t *cache_lookup(ur_decoder_cache_t *cache, const char *type,
+                                 const fountain_encoder_part_t *part) {
+  size_t i = cache_find(cache, type, part->seq_len, part->message_len,
+                        part->checksum);
+  if (i == cache->count || !cache_entry_matches(&cache->entries[i], part))
+    return NULL;
+
+  cache_entry_t *entry = &cache->entries[i];
+  ur_result_t *result = safe_malloc(sizeof(ur_result_t));
+  char *result_type = safe_strdup(entry->type);
+  uint8_t *result_data = safe_malloc_uninit(entry->cbor_len);
+  if (!result || !result_type || !result_data) {
+    free(result);
+    free(result_type);
+    free(result_data);
+    return NULL;
+  }
+  memcpy(result_data, entry->cbor_data, entry->cbor_len);
+  result->type = result_type;
+  result->cbor_data = result_data;
+  result->cbor_len = entry->cbor_len;
+  entry->last_used = ++cache->clock;
+  return result;
+}
+
+void ur_decoder_set_cache(ur_decoder_t *decoder, ur_decoder_cache_t *cache) {
+  if (!decoder)
+    return;
+  decoder->cache = cache;
+}
+
+// The first part fixes the expected type; later parts must match it.
+static ur_decoder_state_t validate_part_type(char **expected_type,
+                                             const char *type) {
+  if (!type)
+    return UR_DECODER_ERROR_INVALID_TYPE;
+
+  if (!*expected_type) {
     if (!is_ur_type(type)) {
-      decoder->state = UR_DECODER_ERROR_INVALID_TYPE;
-      return false;
+      return UR_DECODER_ERROR_INVALID_TYPE;
     }
-    decoder->expected_type = safe_strdup(type);
-    if (!decoder->expected_type) {
-      decoder->state = UR_DECODER_ERROR_MEMORY;
-      return false;
+    *expected_type = safe_strdup(type);
+    if (!*expected_type) {
+      return UR_DECODER_ERROR_MEMORY;
     }
-    return true;
+    return UR_DECODER_PROCESSING;
   }
 
-  if (strcmp(decoder->expected_type, type) != 0) {
-    decoder->state = UR_DECODER_ERROR_INVALID_TYPE;
-    return false;
+  if (strcmp(*expected_type, type) != 0) {
+    return UR_DECODER_ERROR_INVALID_TYPE;
   }
 
-  return true;
+  return UR_DECODER_PROCESSING;
 }
 
 static ur_result_t *decode_single_part(const char *type, const char *body) {
@@ -261,10 +564,11 @@ static ur_decoder_state_t finalize_fountain_result(ur_decoder_t *decoder) {
   size_t result_len =
       fountain_decoder_result_message_len(decoder->fountain_decoder);
   // Steal the reassembled message from the fountain decoder rather
-  // than malloc+memcpy a private copy.
+  // than malloc+memcpy a private copy. With an output sink there is no
+  // copy in memory: the message is in the sink.
   uint8_t *result_data =
       fountain_decoder_take_result_message(decoder->fountain_decoder);
-  if (!result_data || result_len == 0) {
+  if ((!result_data && !decoder->output_sink) || result_len == 0) {
     free(result_data);
     free(result_type);
     free(decoded_result);
@@ -275,80 +579,77 @@ static ur_decoder_state_t finalize_fountain_result(ur_decoder_t *decoder) {
   decoded_result->cbor_data = result_data;
   decoded_result->cbor_len = result_len;
   decoder->result = decoded_result;
+  if (decoder->cache && result_data) {
+    size_t seq_len =
+        fountain_decoder_expected_part_count(decoder->fountain_decoder);
+    cache_insert(decoder->cache, result_type, seq_len,
+                 decoder->cache_checksum, result_data, result_len);
+  }
   return UR_DECODER_OK;
 }
 
-ur_decoder_state_t ur_decoder_receive_part(ur_decoder_t *decoder,
-                                           const char *part_str) {
-  if (!decoder) {
-    return UR_DECODER_ERROR_NULL_POINTER;
-  }
-
-  // Terminal states are permanent; check before the part_str NULL check so
-  // NULL input cannot overwrite a terminal state.
-  if (ur_decoder_state_is_terminal(decoder->state)) {
-    return decoder->state;
-  }
-
-  if (!part_str) {
-    decoder->state = UR_DECODER_ERROR_NULL_POINTER;
-    return decoder->state;
-  }
-
-  decoder->state = UR_DECODER_PROCESSING;
-
-  // Retry path: a prior OOM at the completing frame can leave the fountain
-  // layer complete while this decoder is not yet terminal. Re-attempt the
-  // result materialization instead of parsing the (unneeded) part.
-  if (fountain_decoder_is_complete(decoder->fountain_decoder)) {
-    decoder->state = finalize_fountain_result(decoder);
-    return decoder->state;
-  }
+// Stage one of decoding, shared by submit_part and the pipelined decoder
+// (ur_pipeline.c): parse and validate one part without touching a fountain
+// decoder. The first part's type is stored in *expected_type; later parts
+// must match it. On UR_DECODER_OK *single holds a single-part result; on
+// UR_DECODER_PROCESSING *part holds a fountain part for stage two. Any
+// other return is an error state and nothing is allocated.
+ur_decoder_state_t ur_decoder_parse_part(char **expected_type,
+                                         const char *part_str, size_t part_len,
+                                         ur_result_t **single,
+                                         fountain_encoder_part_t **part,
+                                         size_t max_message_len) {
+  *single = NULL;
+  *part = NULL;
 
   char *type = NULL;
   char **components = NULL;
   size_t component_count = 0;
   uint8_t *cbor_data = NULL;
+  ur_decoder_state_t state = UR_DECODER_PROCESSING;
 
-  if (!parse_ur_string(part_str, &type, &components, &component_count)) {
-    decoder->state = UR_DECODER_ERROR_INVALID_SCHEME;
-    return decoder->state;
+  if (!parse_ur_string_len(part_str, part_len, &type, &components,
+                           &component_count)) {
+    return UR_DECODER_ERROR_INVALID_SCHEME;
   }
 
-  if (!validate_part_type(decoder, type))
+  state = validate_part_type(expected_type, type);
+  if (state != UR_DECODER_PROCESSING)
     goto cleanup;
 
   if (component_count == 1) {
-    decoder->result = decode_single_part(type, components[0]);
-    decoder->state =
-        decoder->result ? UR_DECODER_OK : UR_DECODER_ERROR_INVALID_FRAGMENT;
+    *single = decode_single_part(type, components[0]);
+    state = *single ? UR_DECODER_OK : UR_DECODER_ERROR_INVALID_FRAGMENT;
     goto cleanup;
   }
 
   if (component_count != 2) {
-    decoder->state = UR_DECODER_ERROR_INVALID_PATH_LENGTH;
+    state = UR_DECODER_ERROR_INVALID_PATH_LENGTH;
     goto cleanup;
   }
 
   uint32_t seq_num;
   size_t seq_len;
   if (!parse_sequence_component(components[0], &seq_num, &seq_len)) {
-    decoder->state = UR_DECODER_ERROR_INVALID_SEQUENCE_COMPONENT;
+    state = UR_DECODER_ERROR_INVALID_SEQUENCE_COMPONENT;
     goto cleanup;
   }
-  if (seq_len == 0 || seq_len > UR_MAX_SEQ_LEN) {
-    decoder->state = UR_DECODER_ERROR_INVALID_SEQUENCE_COMPONENT;
+  if (max_message_len == 0) {
+    max_message_len = UR_MAX_MESSAGE_LEN;
+  }
+  if (seq_len == 0 || seq_len > max_seq_len_for(max_message_len)) {
+    state = UR_DECODER_ERROR_INVALID_SEQUENCE_COMPONENT;
     goto cleanup;
   }
 
   size_t cbor_len;
   if (!bytewords_decode_raw(components[1], &cbor_data, &cbor_len)) {
-    decoder->state = UR_DECODER_ERROR_INVALID_FRAGMENT;
+    state = UR_DECODER_ERROR_INVALID_FRAGMENT;
     goto cleanup;
   }
 
   if (cbor_len < 5) {
-    decoder->state = UR_DECODER_ERROR_INVALID_FRAGMENT;
+    state = UR_DECODER_ERROR_INVALID_FRAGMENT;
     goto cleanup;
   }
 
@@ -357,7 +658,7 @@ ur_decoder_state_t ur_decoder_receive_part(ur_decoder_t *decoder,
 
   // Expect CBOR array of 5 elements (0x85)
   if (remaining < 1 || cbor_ptr[0] != 0x85) {
-    decoder->state = UR_DECODER_ERROR_INVALID_FRAGMENT;
+    state = UR_DECODER_ERROR_INVALID_FRAGMENT;
     goto cleanup;
   }
   cbor_ptr++;
@@ -369,7 +670,7 @@ ur_decoder_state_t ur_decoder_receive_part(ur_decoder_t *decoder,
                         &cbor_checksum};
   for (int i = 0; i < 4; i++) {
     if (!cbor_read_uint32(&cbor_ptr, &remaining, values[i])) {
-      decoder->state = UR_DECODER_ERROR_INVALID_FRAGMENT;
+      state = UR_DECODER_ERROR_INVALID_FRAGMENT;
       goto cleanup;
     }
   }
@@ -377,8 +678,8 @@ ur_decoder_state_t ur_decoder_receive_part(ur_decoder_t *decoder,
   // Fragment body must agree with URI path (spec requires it) and fall
   // within the sanity caps.
   if (cbor_seq_num != seq_num || cbor_seq_len != seq_len ||
-      cbor_message_len == 0 || cbor_message_len > UR_MAX_MESSAGE_LEN) {
-    decoder->state = UR_DECODER_ERROR_INVALID_FRAGMENT;
+      cbor_message_len == 0 || cbor_message_len > max_message_len) {
+    state = UR_DECODER_ERROR_INVALID_FRAGMENT;
     goto cleanup;
   }
 
@@ -386,7 +687,7 @@ ur_decoder_state_t ur_decoder_receive_part(ur_decoder_t *decoder,
   const uint8_t *fragment_ptr;
   size_t fragment_len;
   if (!cbor_read_bytes(&cbor_ptr, &remaining, &fragment_ptr, &fragment_len)) {
-    decoder->state = UR_DECODER_ERROR_INVALID_FRAGMENT;
+    state = UR_DECODER_ERROR_INVALID_FRAGMENT;
     goto cleanup;
   }
 
@@ -396,7 +697,7 @@ ur_decoder_state_t ur_decoder_receive_part(ur_decoder_t *decoder,
   // buffer and returns NULL — leaving fragment_data dangling for a
   // double-free on the create_fountain_part_from_cbor failure path.
   if (fragment_len == 0) {
-    decoder->state = UR_DECODER_ERROR_INVALID_FRAGMENT;
+    state = UR_DECODER_ERROR_INVALID_FRAGMENT;
     goto cleanup;
   }
 
@@ -411,36 +712,158 @@ ur_decoder_state_t ur_decoder_receive_part(ur_decoder_t *decoder,
   uint8_t *fragment_data = shrunk ? shrunk : cbor_data;
   cbor_data = NULL; // ownership transferred to fragment_data
 
-  fountain_encoder_part_t *part = create_fountain_part_from_cbor(
-      fragment_data, fragment_len, seq_num, seq_len, true);
-  if (!part) {
+  *part = create_fountain_part_from_cbor(fragment_data, fragment_len, seq_num,
+                                         seq_len, true);
+  if (!*part) {
     free(fragment_data);
-    decoder->state = UR_DECODER_ERROR_MEMORY;
+    state = UR_DECODER_ERROR_MEMORY;
     goto cleanup;
   }
-  part->message_len = cbor_message_len;
-  part->checksum = cbor_checksum;
+  (*part)->message_len = cbor_message_len;
+  (*part)->checksum = cbor_checksum;
 
-  bool success = fountain_decoder_receive_part(decoder->fountain_decoder, part);
-  free_fountain_part(part);
+cleanup:
+  free(cbor_data);
+  free(type);
+  free_string_array(components, component_count);
+  free(components);
+  return state;
+}
+
+// Stage two: feed a parsed fountain part to the decoder (draining the
+// reduction cascade, or only queuing it for ur_decoder_step()) and
+// finalize the result once the fountain layer completes. Does not take
+// ownership of part.
+ur_decoder_state_t ur_decoder_submit_fountain_part(
+    ur_decoder_t *decoder, fountain_encoder_part_t *part, bool drain) {
+  // Same OOM retry as submit_part, for callers that skip that path.
+  if (fountain_decoder_is_complete(decoder->fountain_decoder)) {
+    decoder->state = finalize_fountain_result(decoder);
+    return decoder->state;
+  }
 
-  if (!success) {
+  bool success =
+      drain ? fountain_decoder_receive_part(decoder->fountain_decoder, part)
+            : fountain_decoder_enqueue_part(decoder->fountain_decoder, part);
+  if (decoder->payload_rejected) {
+    decoder->state = UR_DECODER_ERROR_INVALID_PAYLOAD;
+  } else if (!success) {
     decoder->state = UR_DECODER_ERROR_INVALID_PART;
-    goto cleanup;
+  } else if (fountain_decoder_is_complete(decoder->fountain_decoder)) {
+    decoder->state = finalize_fountain_result(decoder);
+  }
+  return decoder->state;
+}
+
+// Shared by receive_part and enqueue_part. With drain set the reduction
+// cascade runs to completion here; otherwise the part is only queued for
+// ur_decoder_step().
+static ur_decoder_state_t submit_part(ur_decoder_t *decoder,
+                                      const char *part_str, size_t part_len,
+                                      bool drain) {
+  if (!decoder) {
+    return UR_DECODER_ERROR_NULL_POINTER;
+  }
+
+  // Terminal states are permanent; check before the part_str NULL check so
+  // NULL input cannot overwrite a terminal state.
+  if (ur_decoder_state_is_terminal(decoder->state)) {
+    return decoder->state;
+  }
+
+  if (!part_str) {
+    decoder->state = UR_DECODER_ERROR_NULL_POINTER;
+    return decoder->state;
   }
 
+  decoder->state = UR_DECODER_PROCESSING;
+
+  // Retry path: a prior OOM at the completing frame can leave the fountain
+  // layer complete while this decoder is not yet terminal. Re-attempt the
+  // result materialization instead of parsing the (unneeded) part.
   if (fountain_decoder_is_complete(decoder->fountain_decoder)) {
     decoder->state = finalize_fountain_result(decoder);
+    return decoder->state;
   }
 
-cleanup:
-  free(cbor_data);
-  free(type);
-  free_string_array(components, component_count);
-  free(components);
+  ur_result_t *single = NULL;
+  fountain_encoder_part_t *part = NULL;
+  decoder->state =
+      ur_decoder_parse_part(&decoder->expected_type, part_str, part_len,
+                            &single, &part, decoder->max_message_len);
+  if (part &&
+      fountain_decoder_expected_part_count(decoder->fountain_decoder) == 0) {
+    // The first frame of a message: remember its checksum for the cache,
+    // and finish here if the message is already in it
+    decoder->cache_checksum = part->checksum;
+    if (decoder->cache && !decoder->output_sink) {
+      single = cache_lookup(decoder->cache, decoder->expected_type, part);
+    }
+    if (single) {
+      ur_decoder_free_fountain_part(part);
+      part = NULL;
+      decoder->state = UR_DECODER_OK;
+    }
+  }
+
+  if (single) {
+    decoder->result = single;
+    if (!payload_accepted(decoder, single->cbor_data, single->cbor_len,
+                          single->cbor_len)) {
+      decoder->state = UR_DECODER_ERROR_INVALID_PAYLOAD;
+    } else if (decoder->prefix_fn) {
+      decoder->prefix_fn(decoder->prefix_ctx, 0, single->cbor_data,
+                         single->cbor_len);
+    }
+  } else if (part) {
+    ur_decoder_submit_fountain_part(decoder, part, drain);
+    ur_decoder_free_fountain_part(part);
+  }
   return decoder->state;
 }
 
+ur_decoder_state_t ur_decoder_receive_part(ur_decoder_t *decoder,
+                                           const char *part_str) {
+  return submit_part(decoder, part_str, part_str ? strlen(part_str) : 0,
+                     true);
+}
+
+ur_decoder_state_t ur_decoder_receive_part_len(ur_decoder_t *decoder,
+                                               const char *part_str,
+                                               size_t part_len) {
+  return submit_part(decoder, part_str, part_len, true);
+}
+
+ur_decoder_state_t ur_decoder_enqueue_part(ur_decoder_t *decoder,
+                                           const char *part_str) {
+  return submit_part(decoder, part_str, part_str ? strlen(part_str) : 0,
+                     false);
+}
+
+ur_decoder_state_t ur_decoder_enqueue_part_len(ur_decoder_t *decoder,
+                                               const char *part_str,
+                                               size_t part_len) {
+  return submit_part(decoder, part_str, part_len, false);
+}
+
+bool ur_decoder_step(ur_decoder_t *decoder, size_t work_budget) {
+  if (!decoder || ur_decoder_state_is_terminal(decoder->state))
+    return false;
+
+  bool more = fountain_decoder_step(decoder->fountain_decoder, work_budget);
+  if (decoder->payload_rejected) {
+    decoder->state = UR_DECODER_ERROR_INVALID_PAYLOAD;
+    return false;
+  }
+  if (fountain_decoder_is_complete(decoder->fountain_decoder)) {
+    // An OOM here is transient; report work left so the caller steps again
+    // and the finalization is retried.
+    decoder->state = finalize_fountain_result(decoder);
+    return decoder->state == UR_DECODER_ERROR_MEMORY;
+  }
+  return more;
+}
+
 ur_decoder_state_t ur_decoder_get_state(const ur_decoder_t *decoder) {
   return decoder ? decoder->state : UR_DECODER_ERROR_NULL_POINTER;
 }
@@ -452,6 +875,18 @@ ur_result_t *ur_decoder_get_result(ur_decoder_t *decoder) {
   return decoder->result;
 }
 
+uint8_t *ur_decoder_take_result_cbor(ur_decoder_t *decoder, size_t *cbor_len) {
+  ur_result_t *result = ur_decoder_get_result(decoder);
+  if (!result || !result->cbor_data || !cbor_len)
+    return NULL;
+
+  uint8_t *cbor_data = result->cbor_data;
+  *cbor_len = result->cbor_len;
+  result->cbor_data = NULL;
+  result->cbor_len = 0;
+  return cbor_data;
+}
+
 size_t ur_decoder_expected_part_count(ur_decoder_t *decoder) {
   if (!decoder || !decoder->fountain_decoder)
     return 0;
@@ -470,6 +905,19 @@ size_t ur_decoder_received_parts_count(ur_decoder_t *decoder) {
   return fountain_decoder_received_parts_count(decoder->fountain_decoder);
 }
 
+size_t ur_decoder_solved_bitmap(ur_decoder_t *decoder, uint8_t *bitmap,
+                                size_t bitmap_len) {
+  if (!decoder || !decoder->fountain_decoder)
+    return 0;
+  return fountain_decoder_solved_bitmap(decoder->fountain_decoder, bitmap,
+                                        bitmap_len);
+}
+
+void ur_decoder_get_stats(ur_decoder_t *decoder, ur_decoder_stats_t *stats) {
+  fountain_decoder_get_stats(decoder ? decoder->fountain_decoder : NULL,
+                             stats);
+}
+
 float ur_decoder_estimated_percent_complete(ur_decoder_t *decoder) {
   if (!decoder || !decoder->fountain_decoder)
     return 0.0f;
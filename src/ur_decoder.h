@@ -1,6 +1,8 @@
 #ifndef UR_DECODER_H
 #define UR_DECODER_H
 
+#include "fountain_decoder.h"
+#include "ur_export.h"
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
@@ -10,7 +12,8 @@
  * processing a part; ur_decoder_get_state() polls it without feeding.
  *
  * Terminal states (UR_DECODER_OK, UR_DECODER_NO_RESULT,
- * UR_DECODER_ERROR_INVALID_CHECKSUM) are permanent: once reached, every
+ * UR_DECODER_ERROR_INVALID_CHECKSUM, UR_DECODER_ERROR_INVALID_PAYLOAD) are
+ * permanent: once reached, every
  * subsequent receive_part() call returns the terminal state without
  * processing the part. All other error states are transient: the offending
  * part was rejected, the state sticks until the next receive_part() call
@@ -37,7 +40,8 @@ typedef enum {
   UR_DECODER_ERROR_INVALID_PART,
   UR_DECODER_ERROR_INVALID_CHECKSUM, /* terminal */
   UR_DECODER_ERROR_MEMORY,
-  UR_DECODER_ERROR_NULL_POINTER
+  UR_DECODER_ERROR_NULL_POINTER,
+  UR_DECODER_ERROR_INVALID_PAYLOAD /* terminal: rejected by payload check */
 } ur_decoder_state_t;
 
 static inline bool ur_decoder_state_is_error(ur_decoder_state_t s) {
@@ -46,11 +50,22 @@ static inline bool ur_decoder_state_is_error(ur_decoder_state_t s) {
 
 static inline bool ur_decoder_state_is_terminal(ur_decoder_state_t s) {
   return s == UR_DECODER_OK || s == UR_DECODER_NO_RESULT ||
-         s == UR_DECODER_ERROR_INVALID_CHECKSUM;
+         s == UR_DECODER_ERROR_INVALID_CHECKSUM ||
+         s == UR_DECODER_ERROR_INVALID_PAYLOAD;
 }
 
+// Judges a payload of the given UR type from its first len bytes (of
+// message_len); returns false to reject it. See ur_decoder_set_payload_check
+// and, for the registry types, src/types/payload_check.h.
+typedef bool (*ur_payload_check_fn)(void *ctx, const char *type,
+                                    const uint8_t *data, size_t len,
+                                    size_t message_len);
+
 typedef struct ur_decoder ur_decoder_t;
-typedef struct fountain_decoder fountain_decoder_t;
+
+// Bounded cache of recently decoded multi-part messages, shared by any
+// number of decoders (see ur_decoder_cache_new)
+typedef struct ur_decoder_cache ur_decoder_cache_t;
 
 typedef struct {
   char *type;
@@ -58,24 +73,141 @@ typedef struct {
   size_t cbor_len;
 } ur_result_t;
 
+// Decoder counters, snapshotted by ur_decoder_get_stats(); the fountain
+// decoder's counters, passed through as they are
+typedef fountain_decoder_stats_t ur_decoder_stats_t;
+
 typedef struct ur_decoder {
   fountain_decoder_t *fountain_decoder;
   char *expected_type;
   ur_result_t *result;
   ur_decoder_state_t state;
+  size_t max_message_len; // 0 = UR_MAX_MESSAGE_LEN
+  bool output_sink;       // multi-part results go to the fountain sink
+  fountain_prefix_fn prefix_fn; // in-order delivery, also for single parts
+  void *prefix_ctx;
+  ur_payload_check_fn payload_check; // run on the first payload bytes
+  void *payload_check_ctx;
+  bool payload_rejected;
+  ur_decoder_cache_t *cache; // not owned; kept across resets
+  uint32_t cache_checksum;   // checksum of the message being decoded
 } ur_decoder_t;
 
 /**
  * Create a new URDecoder instance
  * @return Pointer to URDecoder instance or NULL on error
  */
-ur_decoder_t *ur_decoder_new(void);
+UR_API ur_decoder_t *ur_decoder_new(void);
 
 /**
  * Free URDecoder instance
  * @param decoder Pointer to URDecoder instance
  */
-void ur_decoder_free(ur_decoder_t *decoder);
+UR_API void ur_decoder_free(ur_decoder_t *decoder);
+
+/**
+ * Clear the decoder for the next message, as if newly created, while
+ * keeping the fountain decoder's allocated capacity (see
+ * fountain_decoder_reset). Back-to-back scans of similar messages then
+ * reuse the same tables and buffers. Any result not taken is freed.
+ * @param decoder Pointer to URDecoder instance
+ * @param shrink_threshold Free each retained structure holding more than
+ *                         this many bytes (0 = keep everything)
+ */
+UR_API void ur_decoder_reset(ur_decoder_t *decoder, size_t shrink_threshold);
+
+/**
+ * Reassemble multi-part messages into a sink (e.g. a file, see ur_file.h)
+ * rather than RAM, for payloads larger than the heap. Fragments are written
+ * as they are solved and the checksum is verified by reading them back
+ * (see fountain_decoder_set_sink). On UR_DECODER_OK the result has
+ * cbor_data NULL and cbor_len the payload length; single-part URs, which
+ * fit in one frame, still arrive in cbor_data. Must be called before the
+ * first part; a reset removes the sink and the raised cap.
+ * @param decoder Pointer to URDecoder instance
+ * @param sink Output sink; owned by the decoder from this call on (closed
+ *             on free or reset, or before returning false)
+ * @param max_message_len Largest message accepted, replacing the
+ *                        UR_MAX_MESSAGE_LEN cap (0 keeps it); the seq_len
+ *                        cap grows in proportion
+ * @return true on success; false if a part was already received
+ */
+UR_API bool ur_decoder_set_output_sink(ur_decoder_t *decoder,
+                                       const fountain_sink_t *sink,
+                                       size_t max_message_len);
+
+/**
+ * Receive the CBOR payload in order while it is decoded, e.g. to start
+ * parsing or hashing a large PSBT before the last frame arrives. fn is
+ * called each time the contiguous solved prefix grows (see
+ * fountain_prefix_fn); a single-part UR is delivered in one call. The bytes
+ * are unverified until the decoder reaches UR_DECODER_OK: on
+ * UR_DECODER_ERROR_INVALID_CHECKSUM, discard what was delivered. A reset
+ * clears the callback.
+ * @param decoder Pointer to URDecoder instance
+ * @param fn Callback, or NULL to clear it
+ * @param ctx Passed to fn
+ */
+UR_API void ur_decoder_set_prefix_callback(ur_decoder_t *decoder,
+                                           fountain_prefix_fn fn, void *ctx);
+
+/**
+ * Reject a payload of the wrong shape as soon as its first bytes are known
+ * rather than after the whole animation: fn sees the leading bytes of
+ * fragment 0 when that fragment arrives as a pure part or is solved from
+ * mixed parts (a single-part UR is checked whole). If it returns false the
+ * decoder ends in UR_DECODER_ERROR_INVALID_PAYLOAD, before any prefix
+ * callback sees the data. Must be set before the first part; a reset
+ * clears it.
+ * @param decoder Pointer to URDecoder instance
+ * @param fn Predicate (e.g. registry_payload_check), or NULL to clear it
+ * @param ctx Passed to fn
+ * @return true on success; false if a part was already received
+ */
+UR_API bool ur_decoder_set_payload_check(ur_decoder_t *decoder,
+                                         ur_payload_check_fn fn, void *ctx);
+
+/**
+ * Create a cache of recently decoded multi-part messages, so scanning the
+ * same animated UR again (a confirmation pass, a retry) finishes on its
+ * first frame. Entries are keyed by (type, seq_len, message_len,
+ * checksum); a hit is accepted only if that first frame also matches the
+ * cached message byte for byte. The least recently used entries are
+ * evicted to stay within both limits.
+ * @param max_entries Most messages held (at least 1)
+ * @param max_bytes Most payload bytes held; larger messages are not cached
+ * @return New cache, or NULL on error
+ */
+UR_API ur_decoder_cache_t *ur_decoder_cache_new(size_t max_entries,
+                                                size_t max_bytes);
+
+/**
+ * Free a cache and every message it holds. It cannot detach itself:
+ * detach it from (or free) every decoder using it first, or they keep a
+ * dangling pointer.
+ * @param cache Cache to free (may be NULL)
+ */
+UR_API void ur_decoder_cache_free(ur_decoder_cache_t *cache);
+
+/**
+ * Drop every cached message, e.g. once a transaction is signed
+ * @param cache Cache to empty (may be NULL)
+ */
+UR_API void ur_decoder_cache_clear(ur_decoder_cache_t *cache);
+
+/**
+ * Attach a cache (or detach, with NULL). The decoder stores each
+ * multi-part message it completes and looks up the first frame of the
+ * next one; a hit goes straight to UR_DECODER_OK with a copy of the cached
+ * payload. The cache is not owned and stays attached across resets, so it
+ * must outlive the decoder or be detached (cache NULL) before
+ * ur_decoder_cache_free(). Decoders with an output sink neither use nor
+ * fill it.
+ * @param decoder Pointer to URDecoder instance
+ * @param cache Cache, or NULL
+ */
+UR_API void ur_decoder_set_cache(ur_decoder_t *decoder,
+                                 ur_decoder_cache_t *cache);
 
 /**
  * Receive and process a UR part
@@ -85,36 +217,101 @@ void ur_decoder_free(ur_decoder_t *decoder);
  *         UR_DECODER_ERROR_NULL_POINTER on a NULL decoder; on a terminal
  *         decoder returns the terminal state without processing the part.
  */
-ur_decoder_state_t ur_decoder_receive_part(ur_decoder_t *decoder,
-                                           const char *part_str);
+UR_API ur_decoder_state_t ur_decoder_receive_part(ur_decoder_t *decoder,
+                                                  const char *part_str);
+
+/**
+ * Receive and process a length-delimited UR part. Same contract as
+ * ur_decoder_receive_part(), but part_str need not be NUL-terminated, so
+ * a frame can be fed straight from a camera/QR byte buffer.
+ * @param decoder Pointer to URDecoder instance
+ * @param part_str UR part bytes (ASCII)
+ * @param part_len Number of bytes in part_str
+ * @return Decoder state after processing (see ur_decoder_state_t)
+ */
+UR_API ur_decoder_state_t ur_decoder_receive_part_len(ur_decoder_t *decoder,
+                                                      const char *part_str,
+                                                      size_t part_len);
+
+/**
+ * Parse and validate a UR part and queue it for ur_decoder_step(), without
+ * running the fountain reduction cascade. Lets a UI thread keep each call
+ * short: enqueue frames as they arrive, then step within the frame budget.
+ * Same state contract as ur_decoder_receive_part(); a multi-part decode
+ * stays UR_DECODER_PROCESSING until a step completes it (a single-part UR
+ * completes here).
+ * @param decoder Pointer to URDecoder instance
+ * @param part_str UR part string to process
+ * @return Decoder state after queuing (see ur_decoder_state_t)
+ */
+UR_API ur_decoder_state_t ur_decoder_enqueue_part(ur_decoder_t *decoder,
+                                                  const char *part_str);
+
+/**
+ * Length-delimited ur_decoder_enqueue_part() (see
+ * ur_decoder_receive_part_len()).
+ * @param decoder Pointer to URDecoder instance
+ * @param part_str UR part bytes (ASCII)
+ * @param part_len Number of bytes in part_str
+ * @return Decoder state after queuing (see ur_decoder_state_t)
+ */
+UR_API ur_decoder_state_t ur_decoder_enqueue_part_len(ur_decoder_t *decoder,
+                                                      const char *part_str,
+                                                      size_t part_len);
+
+/**
+ * Advance queued decoding work by whole queued parts until work_budget
+ * bytes of XOR/copy work are done (at least one part per call). One part's
+ * reduction cascade is not split, so a single step can exceed the budget
+ * (see fountain_decoder_step). When the step completes the message, the
+ * decoder state becomes terminal; poll it with ur_decoder_get_state().
+ * @param decoder Pointer to URDecoder instance
+ * @param work_budget Work budget in bytes (0 = one queued part)
+ * @return true if queued work remains (or a failed finalization should be
+ *         retried), false if idle or terminal
+ */
+UR_API bool ur_decoder_step(ur_decoder_t *decoder, size_t work_budget);
 
 /**
  * Get the current decoder state without feeding a part
  * @param decoder Pointer to URDecoder instance
  * @return Current state; UR_DECODER_ERROR_NULL_POINTER if decoder is NULL
  */
-ur_decoder_state_t ur_decoder_get_state(const ur_decoder_t *decoder);
+UR_API ur_decoder_state_t ur_decoder_get_state(const ur_decoder_t *decoder);
 
 /**
  * Get the decoded result
  * @param decoder Pointer to URDecoder instance
  * @return Non-NULL if and only if ur_decoder_get_state() == UR_DECODER_OK
  */
-ur_result_t *ur_decoder_get_result(ur_decoder_t *decoder);
+UR_API ur_result_t *ur_decoder_get_result(ur_decoder_t *decoder);
+
+/**
+ * Transfer ownership of the decoded CBOR to the caller, so a binding can
+ * move it into its own heap without the decoder keeping a second copy.
+ * Afterwards ur_decoder_get_result() still returns the result (state stays
+ * UR_DECODER_OK) but with cbor_data NULL and cbor_len 0.
+ * @param decoder Pointer to URDecoder instance
+ * @param cbor_len Output CBOR length
+ * @return Heap pointer the caller must free, or NULL if there is no result
+ *         or it was already taken
+ */
+UR_API uint8_t *ur_decoder_take_result_cbor(ur_decoder_t *decoder,
+                                            size_t *cbor_len);
 
 /**
  * Get expected part count
  * @param decoder Pointer to URDecoder instance
  * @return Expected part count
  */
-size_t ur_decoder_expected_part_count(ur_decoder_t *decoder);
+UR_API size_t ur_decoder_expected_part_count(ur_decoder_t *decoder);
 
 /**
  * Get processed parts count
  * @param decoder Pointer to URDecoder instance
  * @return Processed parts count
  */
-size_t ur_decoder_processed_parts_count(ur_decoder_t *decoder);
+UR_API size_t ur_decoder_processed_parts_count(ur_decoder_t *decoder);
 
 /**
  * Get the number of unique pure fragments recovered so far (out of
@@ -122,22 +319,42 @@ size_t ur_decoder_processed_parts_count(ur_decoder_t *decoder);
  * @param decoder Pointer to URDecoder instance
  * @return Number of unique received fragment indexes
  */
-size_t ur_decoder_received_parts_count(ur_decoder_t *decoder);
+UR_API size_t ur_decoder_received_parts_count(ur_decoder_t *decoder);
+
+/**
+ * Write the per-fragment solved bitmap (bit i % 8 of byte i / 8 is set once
+ * fragment i is recovered), for an n-of-m grid display.
+ * @param decoder Pointer to URDecoder instance
+ * @param bitmap Output buffer, or NULL to query the size
+ * @param bitmap_len Size of bitmap; nothing is written if it is too small
+ * @return Bitmap size in bytes (0 before the first multi-part frame)
+ */
+UR_API size_t ur_decoder_solved_bitmap(ur_decoder_t *decoder, uint8_t *bitmap,
+                                       size_t bitmap_len);
+
+/**
+ * Snapshot the fountain decoder counters
+ * @param decoder Pointer to URDecoder instance
+ * @param stats Output stats (zeroed when there is no fountain decoder)
+ */
+UR_API void ur_decoder_get_stats(ur_decoder_t *decoder,
+                                 ur_decoder_stats_t *stats);
 
 /**
  * Get estimated completion percentage
  * @param decoder Pointer to URDecoder instance
  * @return Completion percentage (0.0 to 1.0)
  */
-float ur_decoder_estimated_percent_complete(ur_decoder_t *decoder);
+UR_API float ur_decoder_estimated_percent_complete(ur_decoder_t *decoder);
 
 /**
  * Get estimated completion percentage using the weighted-mixed-frames method.
  * @param decoder Pointer to URDecoder instance
  * @return Completion percentage (0.0 to 1.0)
  */
-float ur_decoder_estimated_percent_complete_weighted(ur_decoder_t *decoder);
+UR_API float ur_decoder_estimated_percent_complete_weighted(
+    ur_decoder_t *decoder);
 
-void ur_result_free(ur_result_t *result);
+UR_API void ur_result_free(ur_result_t *result);
 
 #endif // UR_DECODER_H
\ No newline at end of file
@@ -0,0 +1,47 @@
+#ifndef UR_DECODER_INTERNAL_H
+#define UR_DECODER_INTERNAL_H
+
+#include "fountain_types.h"
+#include "ur_decoder.h"
+#include "ur_export.h"
+#include <stdbool.h>
+#include <stddef.h>
+
+// The two decoding stages behind ur_decoder_receive_part(), split so the
+// pipelined decoder (ur_pipeline.c) can run them on different threads.
+
+/**
+ * Parse and validate one UR part (string parse, bytewords + CRC, CBOR
+ * header) without touching a fountain decoder
+ * @param expected_type In/out expected UR type; set by the first part
+ * @param part_str UR part bytes (ASCII)
+ * @param part_len Number of bytes in part_str
+ * @param single Output single-part result (on UR_DECODER_OK)
+ * @param part Output fountain part (on UR_DECODER_PROCESSING); free with
+ *             ur_decoder_free_fountain_part()
+ * @param max_message_len Message length cap (0 = UR_MAX_MESSAGE_LEN)
+ * @return UR_DECODER_OK, UR_DECODER_PROCESSING, or an error state
+ */
+UR_INTERNAL ur_decoder_state_t
+ur_decoder_parse_part(char **expected_type, const char *part_str,
+                      size_t part_len, ur_result_t **single,
+                      fountain_encoder_part_t **part, size_t max_message_len);
+
+/**
+ * Feed a parsed fountain part to the decoder and finalize the result once
+ * the fountain layer completes
+ * @param decoder Pointer to URDecoder instance
+ * @param part Parsed part (data is moved out; the caller still frees it)
+ * @param drain true to run the reduction cascade, false to only queue it
+ * @return Decoder state afterwards
+ */
+UR_INTERNAL ur_decoder_state_t ur_decoder_submit_fountain_part(
+    ur_decoder_t *decoder, fountain_encoder_part_t *part, bool drain);
+
+/**
+ * Free a part returned by ur_decoder_parse_part()
+ * @param part Part to free (may be NULL)
+ */
+UR_INTERNAL void ur_decoder_free_fountain_part(fountain_encoder_part_t *part);
+
+#endif // UR_DECODER_INTERNAL_H
@@ -89,38 +89,63 @@ bool ur_encoder_encode_single(const char *type, const uint8_t *cbor_data,
   return true;
 }
 
-ur_encoder_t *ur_encoder_new(const char *type, const uint8_t *cbor_data,
-                             size_t cbor_len, size_t max_fragment_len,
-                             uint32_t first_seq_num, size_t min_fragment_len) {
-  if (!type || !cbor_data || cbor_len == 0) {
+// Helper: Wrap a fountain encoder under a copy of type. Takes ownership of
+// fountain_encoder, freeing it on failure.
+static ur_encoder_t *ur_encoder_wrap(const char *type,
+                                     fountain_encoder_t *fountain_encoder) {
+  if (!fountain_encoder) {
     return NULL;
   }
 
   ur_encoder_t *encoder = (ur_encoder_t *)calloc(1, sizeof(ur_encoder_t));
   if (!encoder) {
+    fountain_encoder_free(fountain_encoder);
     return NULL;
   }
 
   // Copy type
   encoder->type = (char *)malloc(strlen(type) + 1);
   if (!encoder->type) {
+    fountain_encoder_free(fountain_encoder);
     free(encoder);
     return NULL;
   }
   strcpy(encoder->type, type);
 
+  encoder->fountain_encoder = fountain_encoder;
+  return encoder;
+}
+
+ur_encoder_t *ur_encoder_new(const char *type, const uint8_t *cbor_data,
+                             size_t cbor_len, size_t max_fragment_len,
+                             uint32_t first_seq_num, size_t min_fragment_len) {
+  if (!type || !cbor_data || cbor_len == 0) {
+    return NULL;
+  }
+
   // fountain_encoder_new partitions the payload into its own fragment
   // buffers; we don't need to keep a second copy in the ur_encoder.
-  encoder->fountain_encoder = fountain_encoder_new(
+  fountain_encoder_t *fountain_encoder = fountain_encoder_new(
       cbor_data, cbor_len, max_fragment_len, first_seq_num, min_fragment_len);
+  return ur_encoder_wrap(type, fountain_encoder);
+}
 
-  if (!encoder->fountain_encoder) {
-    free(encoder->type);
-    free(encoder);
+ur_encoder_t *ur_encoder_new_from_source(const char *type,
+                                         const fountain_source_t *source,
+                                         size_t cbor_len,
+                                         size_t max_fragment_len,
+                                         uint32_t first_seq_num,
+                                         size_t min_fragment_len) {
+  if (!type) {
+    if (source && source->close) {
+      source->close(source->ctx);
+    }
     return NULL;
   }
 
-  return encoder;
+  fountain_encoder_t *fountain_encoder = fountain_encoder_new_from_source(
+      source, cbor_len, max_fragment_len, first_seq_num, min_fragment_len);
+  return ur_encoder_wrap(type, fountain_encoder);
 }
 
 void ur_encoder_free(ur_encoder_t *encoder) {
@@ -145,7 +170,7 @@ bool ur_encoder_is_complete(const ur_encoder_t *encoder) {
     return false;
   }
   return encoder->fountain_encoder->seq_num >=
-         encoder->fountain_encoder->fragments.count;
+         fountain_encoder_seq_len(encoder->fountain_encoder);
 }
 
 bool ur_encoder_is_single_part(const ur_encoder_t *encoder) {
@@ -208,9 +233,10 @@ bool ur_encoder_next_part(ur_encoder_t *encoder, char **ur_part_out) {
   // Still advance seq_num so ur_encoder_is_complete() becomes true once
   // the part has been emitted (matching multi-part behaviour).
   if (ur_encoder_is_single_part(encoder)) {
-    const fragment_array_t *frags = &encoder->fountain_encoder->fragments;
-    if (!ur_encoder_encode_single(encoder->type, frags->fragments[0],
-                                  frags->fragment_lens[0], ur_part_out)) {
+    fountain_encoder_t *fe = encoder->fountain_encoder;
+    const uint8_t *payload = fountain_encoder_fragment(fe, 0);
+    if (!payload || !ur_encoder_encode_single(encoder->type, payload,
+                                              fe->fragment_len, ur_part_out)) {
       return false;
     }
     encoder->fountain_encoder->seq_num++;
@@ -232,3 +258,101 @@ bool ur_encoder_next_part(ur_encoder_t *encoder, char **ur_part_out) {
 
   return success;
 }
+
+// Helper: Size of a CBOR unsigned/length head for value
+static size_t cbor_head_len(uint64_t value) {
+  if (value < 24)
+    return 1;
+  if (value <= 0xFF)
+    return 2;
+  if (value <= 0xFFFF)
+    return 3;
+  if (value <= 0xFFFFFFFFu)
+    return 5;
+  return 9;
+}
+
+// Helper: Copy src uppercased (alphanumeric QR mode), return chars written
+static size_t put_upper(char *out, const char *src) {
+  size_t n = 0;
+  for (; src[n]; n++) {
+    out[n] = (char)toupper((unsigned char)src[n]);
+  }
+  return n;
+}
+
+size_t ur_encoder_part_buffer_len(const ur_encoder_t *encoder) {
+  if (!encoder || !encoder->fountain_encoder) {
+    return 0;
+  }
+  const fountain_encoder_t *fe = encoder->fountain_encoder;
+
+  // "UR:" + type + "/"
+  size_t len = 3 + strlen(encoder->type) + 1;
+  size_t cbor_len;
+  if (ur_encoder_is_single_part(encoder)) {
+    cbor_len = fe->fragment_len;
+  } else {
+    // "<seq_num>-<seq_len>/" with seq_num at its uint32 maximum, and the
+    // [seq_num, seq_len, message_len, checksum, data] CBOR array
+    len += 10 + 1 + 10 + 1;
+    cbor_len = 1 + cbor_head_len(UINT32_MAX) +
+               cbor_head_len(fe->seq_len) +
+               cbor_head_len(fe->message_len) + cbor_head_len(UINT32_MAX) +
+               cbor_head_len(fe->fragment_len) + fe->fragment_len;
+  }
+  // Bytewords (CRC32 appended) + NUL
+  return len + (cbor_len + 4) * 2 + 1;
+}
+
+bool ur_encoder_next_part_into(ur_encoder_t *encoder, char *buf,
+                               size_t buf_len, size_t *part_len) {
+  if (!encoder || !buf || !part_len) {
+    return false;
+  }
+  // Size-check against the bound before generating, so a short buffer
+  // never consumes a sequence number.
+  size_t needed = ur_encoder_part_buffer_len(encoder);
+  if (needed == 0 || buf_len < needed) {
+    return false;
+  }
+
+  char *pos = buf;
+  pos += put_upper(pos, "ur:");
+  pos += put_upper(pos, encoder->type);
+  *pos++ = '/';
+
+  if (ur_encoder_is_single_part(encoder)) {
+    fountain_encoder_t *fe = encoder->fountain_encoder;
+    const uint8_t *payload = fountain_encoder_fragment(fe, 0);
+    if (!payload) {
+      return false;
+    }
+    pos += bytewords_encode_into(payload, fe->fragment_len, pos);
+    fe->seq_num++;
+  } else {
+    fountain_encoder_part_t part;
+    memset(&part, 0, sizeof(part));
+    if (!fountain_encoder_next_part(encoder->fountain_encoder, &part)) {
+      return false;
+    }
+
+    uint8_t *cbor = NULL;
+    size_t cbor_len = 0;
+    bool ok = fountain_encoder_part_to_cbor(&part, &cbor, &cbor_len);
+    if (ok) {
+      pos += sprintf(pos, "%" PRIu32 "-%" PRIu32 "/", part.seq_num,
+                     (uint32_t)part.seq_len);
+      pos += bytewords_encode_into(cbor, cbor_len, pos);
+    }
+    free(cbor);
+    fountain_encoder_part_free(&part);
+    if (!ok) {
+      return false;
+    }
+  }
+
+  *pos = '\0';
+  *part_len = (size_t)(pos - buf);
+  return true;
+}
@@ -3,6 +3,7 @@
 
 #include "fountain_encoder.h"
 #include "ur.h"
+#include "ur_export.h"
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
@@ -14,8 +15,8 @@
 typedef struct ur_encoder ur_encoder_t;
 
 // UR encoder structure. The CBOR payload lives inside fountain_encoder
-// (partitioned into fragments); for single-part encodes we read from
-// fragments[0] directly instead of keeping a second copy.
+// (partitioned into fragments, or behind its source); for single-part
+// encodes we read fragment 0 directly instead of keeping a second copy.
 typedef struct ur_encoder {
   char *type;
   fountain_encoder_t *fountain_encoder;
@@ -30,8 +31,8 @@ typedef struct ur_encoder {
  * by caller)
  * @return true on success
  */
-bool ur_encoder_encode_single(const char *type, const uint8_t *cbor_data,
-                              size_t cbor_len, char **ur_string_out);
+UR_API bool ur_encoder_encode_single(const char *type, const uint8_t *cbor_data,
+                                     size_t cbor_len, char **ur_string_out);
 
 /**
  * Create new UR encoder for multi-part encoding
@@ -43,36 +44,58 @@ bool ur_encoder_encode_single(const char *type, const uint8_t *cbor_data,
  * @param min_fragment_len Minimum fragment length (default 10)
  * @return Pointer to encoder or NULL on error
  */
-ur_encoder_t *ur_encoder_new(const char *type, const uint8_t *cbor_data,
-                             size_t cbor_len, size_t max_fragment_len,
-                             uint32_t first_seq_num, size_t min_fragment_len);
+UR_API ur_encoder_t *ur_encoder_new(const char *type, const uint8_t *cbor_data,
+                                    size_t cbor_len, size_t max_fragment_len,
+                                    uint32_t first_seq_num,
+                                    size_t min_fragment_len);
+
+/**
+ * Create new UR encoder reading the CBOR payload from a source (a file, a
+ * chunked store) rather than one contiguous buffer; see
+ * fountain_encoder_new_from_source(). Encoder memory stays at one fragment
+ * however large the payload.
+ * @param type UR type
+ * @param source Payload source; owned by the encoder from this call on
+ *               (closed on free, or before returning NULL)
+ * @param cbor_len Length of the CBOR payload
+ * @param max_fragment_len Maximum fragment length
+ * @param first_seq_num First sequence number (default 0)
+ * @param min_fragment_len Minimum fragment length (default 10)
+ * @return Pointer to encoder or NULL on error
+ */
+UR_API ur_encoder_t *ur_encoder_new_from_source(const char *type,
+                                                const fountain_source_t *source,
+                                                size_t cbor_len,
+                                                size_t max_fragment_len,
+                                                uint32_t first_seq_num,
+                                                size_t min_fragment_len);
 
 /**
  * Free UR encoder
  * @param encoder Pointer to encoder
  */
-void ur_encoder_free(ur_encoder_t *encoder);
+UR_API void ur_encoder_free(ur_encoder_t *encoder);
 
 /**
  * Get sequence length
  * @param encoder Pointer to encoder
  * @return Sequence length
  */
-size_t ur_encoder_seq_len(const ur_encoder_t *encoder);
+UR_API size_t ur_encoder_seq_len(const ur_encoder_t *encoder);
 
 /**
  * Check if encoder is complete
  * @param encoder Pointer to encoder
  * @return true if complete
  */
-bool ur_encoder_is_complete(const ur_encoder_t *encoder);
+UR_API bool ur_encoder_is_complete(const ur_encoder_t *encoder);
 
 /**
  * Check if encoder is single part
  * @param encoder Pointer to encoder
  * @return true if single part
  */
-bool ur_encoder_is_single_part(const ur_encoder_t *encoder);
+UR_API bool ur_encoder_is_single_part(const ur_encoder_t *encoder);
 
 /**
  * Generate next UR part (sequential retrieval)
@@ -81,6 +104,30 @@ bool ur_encoder_is_single_part(const ur_encoder_t *encoder);
  * freed by caller)
  * @return true on success
  */
-bool ur_encoder_next_part(ur_encoder_t *encoder, char **ur_part_out);
+UR_API bool ur_encoder_next_part(ur_encoder_t *encoder, char **ur_part_out);
+
+/**
+ * Buffer size that fits any part this encoder emits, NUL terminator
+ * included. Constant for the encoder's lifetime, so a display loop can
+ * allocate one frame buffer up front.
+ * @param encoder Pointer to encoder
+ * @return Buffer size in bytes, or 0 on error
+ */
+UR_API size_t ur_encoder_part_buffer_len(const ur_encoder_t *encoder);
+
+/**
+ * Generate next UR part into a caller-supplied buffer. Produces the same
+ * part as ur_encoder_next_part() would. Only the output string is
+ * allocation-free: a multi-part frame still mallocs and frees its fragment
+ * indexes, mixed fragment and CBOR encoding internally.
+ * @param encoder Pointer to encoder
+ * @param buf Output buffer; receives the NUL-terminated part
+ * @param buf_len Size of buf; must be >= ur_encoder_part_buffer_len(), else
+ * the call fails without advancing the encoder
+ * @param part_len Output part length, excluding the NUL terminator
+ * @return true on success
+ */
+UR_API bool ur_encoder_next_part_into(ur_encoder_t *encoder, char *buf,
+                                      size_t buf_len, size_t *part_len);
 
 #endif // UR_ENCODER_H
@@ -0,0 +1,32 @@
+#ifndef UR_EXPORT_H
+#define UR_EXPORT_H
+
+// Symbol visibility for the public C API. Library objects are compiled with
+// -fvisibility=hidden, so a shared build (libur.so) exports only the
+// declarations marked UR_API; static builds link exactly as before.
+// Windows DLL builds define UR_SHARED, plus UR_BUILDING_LIBRARY while
+// compiling the library itself.
+#if defined(_WIN32) && defined(UR_SHARED)
+#if defined(UR_BUILDING_LIBRARY)
+#define UR_API __declspec(dllexport)
+#else
+#define UR_API __declspec(dllimport)
+#endif
+#elif defined(__GNUC__) && __GNUC__ >= 4
+#define UR_API __attribute__((visibility("default")))
+#else
+#define UR_API
+#endif
+
+// Library-internal helpers shared between translation units. In the
+// single-file amalgamation (scripts/amalgamate.sh defines UR_AMALGAMATION)
+// they become static, so nothing but UR_API leaks out of ur_amalgamated.o.
+#if defined(UR_AMALGAMATION) && defined(__GNUC__)
+#define UR_INTERNAL static __attribute__((unused))
+#elif defined(UR_AMALGAMATION)
+#define UR_INTERNAL static
+#else
+#define UR_INTERNAL
+#endif
+
+#endif // UR_EXPORT_H
@@ -0,0 +1,174 @@
+//
+// ur_file.c
+//
+// Copyright © 2025 Krux Contributors
+// Licensed under the "BSD-2-Clause Plus Patent License"
+//
+// Memory-mapped file sources for the streaming encoder constructors and
+// file sinks for the decoder.
+//
+
+// ftruncate() is POSIX.1-2001, which strict C99 builds declare only when
+// asked for before the first system header
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200112L
+#endif
+
+#include "ur_file.h"
+
+#if UR_FILE_SOURCE
+
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+typedef struct {
+  const uint8_t *map;
+  size_t len;
+} file_source_t;
+
+static bool file_source_read(void *ctx, size_t offset, uint8_t *buf,
+                             size_t len) {
+  const file_source_t *file = (const file_source_t *)ctx;
+  if (offset > file->len || len > file->len - offset)
+    return false;
+  memcpy(buf, file->map + offset, len);
+  return true;
+}
+
+static void file_source_close(void *ctx) {
+  file_source_t *file = (file_source_t *)ctx;
+  munmap((void *)file->map, file->len);
+  free(file);
+}
+
+bool ur_file_source_from_fd(int fd, fountain_source_t *source,
+                            size_t *len_out) {
+  if (fd < 0 || !source || !len_out)
+    return false;
+
+  struct stat st;
+  if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size <= 0 ||
+      (unsigned long long)st.st_size > SIZE_MAX)
+    return false;
+
+  file_source_t *file = (file_source_t *)malloc(sizeof(file_source_t));
+  if (!file)
+    return false;
+
+  file->len = (size_t)st.st_size;
+  void *map = mmap(NULL, file->len, PROT_READ, MAP_PRIVATE, fd, 0);
+  if (map == MAP_FAILED) {
+    free(file);
+    return false;
+  }
+  file->map = (const uint8_t *)map;
+
+  source->read = file_source_read;
+  source->close = file_source_close;
+  source->ctx = file;
+  *len_out = file->len;
+  return true;
+}
+
+bool ur_file_source_open(const char *path, fountain_source_t *source,
+                         size_t *len_out) {
+  if (!path)
+    return false;
+
+  int fd = open(path, O_RDONLY);
+  if (fd < 0)
+    return false;
+
+  bool ok = ur_file_source_from_fd(fd, source, len_out);
+  close(fd);
+  return ok;
+}
+
+typedef struct {
+  int fd;
+  uint8_t *map; // NULL until begin
+  size_t len;
+} file_sink_t;
+
+static bool file_sink_begin(void *ctx, size_t message_len) {
+  file_sink_t *file = (file_sink_t *)ctx;
+  if (file->map) {
+    if (file->len == message_len)
+      return true;
+    munmap(file->map, file->len);
+    file->map = NULL;
+  }
+  // The length must fit off_t (32 bits on some 32-bit targets)
+  off_t size = (off_t)message_len;
+  if (message_len == 0 || size <= 0 || (size_t)size != message_len)
+    return false;
+
+  // Size the file to the message: growth is a hole, and a longer earlier
+  // message's tail is cut off
+  if (ftruncate(file->fd, size) != 0)
+    return false;
+
+  void *map = mmap(NULL, message_len, PROT_READ | PROT_WRITE, MAP_SHARED,
+                   file->fd, 0);
+  if (map == MAP_FAILED)
+    return false;
+  file->map = (uint8_t *)map;
+  file->len = message_len;
+  return true;
+}
+
+static bool file_sink_write(void *ctx, size_t offset, const uint8_t *buf,
+                            size_t len) {
+  file_sink_t *file = (file_sink_t *)ctx;
+  if (!file->map || offset > file->len || len > file->len - offset)
+    return false;
+  memcpy(file->map + offset, buf, len);
+  return true;
+}
+
+static bool file_sink_read(void *ctx, size_t offset, uint8_t *buf,
+                           size_t len) {
+  const file_sink_t *file = (const file_sink_t *)ctx;
+  if (!file->map || offset > file->len || len > file->len - offset)
+    return false;
+  memcpy(buf, file->map + offset, len);
+  return true;
+}
+
+static void file_sink_close(void *ctx) {
+  file_sink_t *file = (file_sink_t *)ctx;
+  if (file->map) {
+    munmap(file->map, file->len);
+  }
+  close(file->fd);
+  free(file);
+}
+
+bool ur_file_sink_open(const char *path, fountain_sink_t *sink) {
+  if (!path || !sink)
+    return false;
+
+  file_sink_t *file = (file_sink_t *)calloc(1, sizeof(file_sink_t));
+  if (!file)
+    return false;
+
+  file->fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (file->fd < 0) {
+    free(file);
+    return false;
+  }
+
+  sink->begin = file_sink_begin;
+  sink->write = file_sink_write;
+  sink->read = file_sink_read;
+  sink->close = file_sink_close;
+  sink->ctx = file;
+  return true;
+}
+
+#endif // UR_FILE_SOURCE
@@ -0,0 +1,63 @@
+#ifndef UR_FILE_H
+#define UR_FILE_H
+
+#include "fountain_decoder.h"
+#include "fountain_encoder.h"
+#include "ur_export.h"
+#include <stdbool.h>
+#include <stddef.h>
+
+// Memory-mapped files as encoder sources (fountain_encoder_new_from_source,
+// ur_encoder_new_from_source) and decoder sinks (fountain_decoder_set_sink,
+// ur_decoder_set_output_sink). Payload bytes are copied to and from the
+// mapping, never held on the heap, and the kernel can write back and drop
+// their pages under memory pressure. Available where mmap() is (Linux, the
+// BSDs, macOS); build with UR_FILE_SOURCE=0 to leave it out.
+#ifndef UR_FILE_SOURCE
+#if defined(__unix__) || defined(__APPLE__)
+#define UR_FILE_SOURCE 1
+#else
+#define UR_FILE_SOURCE 0
+#endif
+#endif
+
+#if UR_FILE_SOURCE
+
+/**
+ * Map an open file as a message source. The mapping does not keep fd in
+ * use: the caller may close it once this returns.
+ * @param fd File descriptor open for reading (a regular file, not a pipe)
+ * @param source Output source; hand it to an encoder, or release it with
+ *               source->close(source->ctx)
+ * @param len_out Output file length (the message length)
+ * @return true on success; false on error, including an empty file
+ */
+UR_API bool ur_file_source_from_fd(int fd, fountain_source_t *source,
+                                   size_t *len_out);
+
+/**
+ * Open and map a file as a message source (see ur_file_source_from_fd)
+ * @param path File path
+ * @param source Output source
+ * @param len_out Output file length (the message length)
+ * @return true on success
+ */
+UR_API bool ur_file_source_open(const char *path, fountain_source_t *source,
+                                size_t *len_out);
+
+/**
+ * Create (or truncate) a file as a decoder output sink. The file is sized
+ * to the message length and mapped when the first part arrives; once the
+ * decoder reports success it holds the verified message. The file is
+ * sparse until written, so running out of disk space faults (SIGBUS)
+ * rather than failing a write: check free space for large messages.
+ * @param path File path
+ * @param sink Output sink; hand it to a decoder, or release it with
+ *             sink->close(sink->ctx)
+ * @return true on success
+ */
+UR_API bool ur_file_sink_open(const char *path, fountain_sink_t *sink);
+
+#endif // UR_FILE_SOURCE
+
+#endif // UR_FILE_H
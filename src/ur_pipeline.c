@@ -0,0 +1,359 @@
+//
+// ur_pipeline.c
+//
+// Copyright © 2025 Krux Contributors
+// Licensed under the "BSD-2-Clause Plus Patent License"
+//
+// Two-stage pipelined UR decoder: parsing on the producer thread, fountain
+// reduction on a dedicated reducer thread, joined by a lock-free SPSC ring.
+//
+
+#include "ur_pipeline.h"
+#include "fountain_decoder.h"
+#include "ur_decoder_internal.h"
+#include "ur_thread.h"
+#include "utils.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define PIPELINE_DEFAULT_CAPACITY 16
+// Recently submitted sequence numbers the producer filters as duplicates.
+// A camera re-reads the same QR frame many times in a row, so a short
+// window catches almost all of them before they cost a ring slot.
+#define PIPELINE_RECENT_SEQ 32
+
+struct ur_pipeline {
+  // SPSC ring of parsed parts. head is written only by the producer, tail
+  // only by the reducer; each is published with an atomic store and read
+  // with an atomic load by the other side.
+  fountain_encoder_part_t **slots;
+  size_t mask;
+  size_t head;
+  size_t tail;
+
+  // Reducer side: owns the decoder until the pipeline is freed.
+  ur_decoder_t *decoder;
+  ur_thread_t thread;
+  bool thread_started;
+
+  // Sleep/wake for an idle reducer. The producer only takes the mutex
+  // when reducer_sleeping is set, so the common path stays lock-free.
+  ur_mutex_t lock;
+  ur_cond_t wake;
+  ur_cond_t idle;
+  bool reducer_sleeping;
+  bool stop;
+
+  // Published for any thread (atomic access)
+  int state;
+  size_t received_parts;
+  size_t expected_parts;
+  size_t dropped_parts;
+
+  // Producer side
+  ur_result_t *single_result;
+  uint32_t recent_seq[PIPELINE_RECENT_SEQ];
+  size_t recent_count;
+  size_t recent_next;
+};
+
+static bool ring_push(ur_pipeline_t *pipeline, fountain_encoder_part_t *part) {
+  size_t head = pipeline->head;
+  size_t tail = __atomic_load_n(&pipeline->tail, __ATOMIC_ACQUIRE);
+  if (head - tail > pipeline->mask)
+    return false;
+
+  pipeline->slots[head & pipeline->mask] = part;
+  // Sequentially consistent, paired with the reducer's store to
+  // reducer_sleeping: either the reducer sees this part before sleeping or
+  // the producer sees it asleep and wakes it.
+  __atomic_store_n(&pipeline->head, head + 1, __ATOMIC_SEQ_CST);
+  return true;
+}
+
+static fountain_encoder_part_t *ring_pop(ur_pipeline_t *pipeline) {
+  size_t tail = pipeline->tail;
+  size_t head = __atomic_load_n(&pipeline->head, __ATOMIC_SEQ_CST);
+  if (tail == head)
+    return NULL;
+
+  fountain_encoder_part_t *part = pipeline->slots[tail & pipeline->mask];
+  __atomic_store_n(&pipeline->tail, tail + 1, __ATOMIC_RELEASE);
+  return part;
+}
+
+static bool ring_is_empty(ur_pipeline_t *pipeline) {
+  return __atomic_load_n(&pipeline->head, __ATOMIC_SEQ_CST) ==
+         __atomic_load_n(&pipeline->tail, __ATOMIC_ACQUIRE);
+}
+
+// Held in state while the producer stores a single-part result; readers
+// see it as PROCESSING until the result is published.
+#define PIPELINE_STATE_CLAIMED (-1)
+
+// Move the published state from PROCESSING to a terminal state. The first
+// terminal state wins (a single-part UR on the producer side can race a
+// completing fountain decode on the reducer side).
+static void publish_terminal(ur_pipeline_t *pipeline,
+                             ur_decoder_state_t state) {
+  int expected = UR_DECODER_PROCESSING;
+  __atomic_compare_exchange_n(&pipeline->state, &expected, (int)state, false,
+                              __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+}
+
+// Publish a single-part result unless the reducer already reached a
+// terminal state. The state is claimed first so single_result is written
+// only by the winner and only before readers can see UR_DECODER_OK; the
+// loser's result is freed.
+static void publish_single(ur_pipeline_t *pipeline, ur_result_t *single) {
+  int expected = UR_DECODER_PROCESSING;
+  if (!__atomic_compare_exchange_n(&pipeline->state, &expected,
+                                   PIPELINE_STATE_CLAIMED, false,
+                                   __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+    ur_result_free(single);
+    return;
+  }
+  pipeline->single_result = single;
+  __atomic_store_n(&pipeline->state, (int)UR_DECODER_OK, __ATOMIC_RELEASE);
+}
+
+static void reduce_part(ur_pipeline_t *pipeline,
+                        fountain_encoder_part_t *part) {
+  ur_decoder_t *decoder = pipeline->decoder;
+  if (ur_decoder_state_is_terminal(decoder->state))
+    return;
+
+  decoder->state = UR_DECODER_PROCESSING;
+  ur_decoder_state_t state =
+      ur_decoder_submit_fountain_part(decoder, part, true);
+
+  __atomic_store_n(&pipeline->received_parts,
+                   ur_decoder_received_parts_count(decoder), __ATOMIC_RELAXED);
+  __atomic_store_n(&pipeline->expected_parts,
+                   ur_decoder_expected_part_count(decoder), __ATOMIC_RELAXED);
+  if (ur_decoder_state_is_terminal(state))
+    publish_terminal(pipeline, state);
+}
+
+static void *reducer_main(void *arg) {
+  ur_pipeline_t *pipeline = arg;
+
+  for (;;) {
+    fountain_encoder_part_t *part = ring_pop(pipeline);
+    if (part) {
+      reduce_part(pipeline, part);
+      ur_decoder_free_fountain_part(part);
+      continue;
+    }
+
+    ur_mutex_lock(&pipeline->lock);
+    __atomic_store_n(&pipeline->reducer_sleeping, true, __ATOMIC_SEQ_CST);
+    while (ring_is_empty(pipeline) && !pipeline->stop) {
+      ur_cond_broadcast(&pipeline->idle);
+      ur_cond_wait(&pipeline->wake, &pipeline->lock);
+    }
+    __atomic_store_n(&pipeline->reducer_sleeping, false, __ATOMIC_SEQ_CST);
+    bool stop = pipeline->stop;
+    ur_mutex_unlock(&pipeline->lock);
+
+    if (stop)
+      break;
+  }
+
+  return NULL;
+}
+
+ur_pipeline_t *ur_pipeline_new(size_t ring_capacity) {
+  if (ring_capacity == 0)
+    ring_capacity = PIPELINE_DEFAULT_CAPACITY;
+  size_t capacity = 1;
+  while (capacity < ring_capacity) {
+    if (capacity > SIZE_MAX / 2 / sizeof(fountain_encoder_part_t *))
+      return NULL;
+    capacity *= 2;
+  }
+
+  ur_pipeline_t *pipeline = safe_malloc(sizeof(ur_pipeline_t));
+  if (!pipeline)
+    return NULL;
+
+  pipeline->slots = safe_malloc(capacity * sizeof(fountain_encoder_part_t *));
+  pipeline->decoder = ur_decoder_new();
+  if (!pipeline->slots || !pipeline->decoder) {
+    ur_decoder_free(pipeline->decoder);
+    safe_free(pipeline->slots);
+    free(pipeline);
+    return NULL;
+  }
+  pipeline->mask = capacity - 1;
+  pipeline->state = UR_DECODER_PROCESSING;
+
+  if (!ur_mutex_init(&pipeline->lock)) {
+    ur_decoder_free(pipeline->decoder);
+    safe_free(pipeline->slots);
+    free(pipeline);
+    return NULL;
+  }
+  if (!ur_cond_init(&pipeline->wake) || !ur_cond_init(&pipeline->idle)) {
+    // A failed cond init leaves nothing to destroy on the pthreads shim
+    ur_mutex_destroy(&pipeline->lock);
+    ur_decoder_free(pipeline->decoder);
+    safe_free(pipeline->slots);
+    free(pipeline);
+    return NULL;
+  }
+
+  pipeline->thread_started =
+      ur_thread_start(&pipeline->thread, reducer_main, pipeline);
+  if (!pipeline->thread_started) {
+    ur_pipeline_free(pipeline);
+    return NULL;
+  }
+
+  return pipeline;
+}
+
+void ur_pipeline_free(ur_pipeline_t *pipeline) {
+  if (!pipeline)
+    return;
+
+  if (pipeline->thread_started) {
+    ur_mutex_lock(&pipeline->lock);
+    pipeline->stop = true;
+    ur_cond_signal(&pipeline->wake);
+    ur_mutex_unlock(&pipeline->lock);
+    ur_thread_join(pipeline->thread);
+  }
+
+  fountain_encoder_part_t *part;
+  while ((part = ring_pop(pipeline)) != NULL) {
+    ur_decoder_free_fountain_part(part);
+  }
+
+  ur_cond_destroy(&pipeline->idle);
+  ur_cond_destroy(&pipeline->wake);
+  ur_mutex_destroy(&pipeline->lock);
+
+  if (pipeline->single_result) {
+    ur_result_free(pipeline->single_result);
+  }
+  ur_decoder_free(pipeline->decoder);
+  safe_free(pipeline->slots);
+  free(pipeline);
+}
+
+// Producer-side duplicate filter over the last PIPELINE_RECENT_SEQ
+// sequence numbers pushed to the ring. Returns true if seq_num was pushed
+// recently.
+static bool recent_seq_contains(const ur_pipeline_t *pipeline,
+                                uint32_t seq_num) {
+  for (size_t i = 0; i < pipeline->recent_count; i++) {
+    if (pipeline->recent_seq[i] == seq_num)
+      return true;
+  }
+  return false;
+}
+
+static void recent_seq_add(ur_pipeline_t *pipeline, uint32_t seq_num) {
+  pipeline->recent_seq[pipeline->recent_next] = seq_num;
+  pipeline->recent_next = (pipeline->recent_next + 1) % PIPELINE_RECENT_SEQ;
+  if (pipeline->recent_count < PIPELINE_RECENT_SEQ)
+    pipeline->recent_count++;
+}
+
+ur_decoder_state_t ur_pipeline_submit(ur_pipeline_t *pipeline,
+                                      const char *part_str, size_t part_len) {
+  if (!pipeline || !part_str)
+    return UR_DECODER_ERROR_NULL_POINTER;
+
+  ur_decoder_state_t state = ur_pipeline_get_state(pipeline);
+  if (ur_decoder_state_is_terminal(state))
+    return state;
+
+  // expected_type is written here, by the producer, only while it is
+  // unset. The ring's release/acquire pairing publishes it to the reducer
+  // before the first part it reads, and it never changes afterwards.
+  ur_result_t *single = NULL;
+  fountain_encoder_part_t *part = NULL;
+  state = ur_decoder_parse_part(&pipeline->decoder->expected_type, part_str,
+                                part_len, &single, &part,
+                                pipeline->decoder->max_message_len);
+
+  if (single) {
+    publish_single(pipeline, single);
+    return ur_pipeline_get_state(pipeline);
+  }
+  if (!part)
+    return state;
+
+  uint32_t seq_num = part->seq_num;
+  if (recent_seq_contains(pipeline, seq_num)) {
+    ur_decoder_free_fountain_part(part);
+    return UR_DECODER_PROCESSING;
+  }
+
+  // A dropped part is not recorded, so its next re-read is pushed again
+  if (!ring_push(pipeline, part)) {
+    ur_decoder_free_fountain_part(part);
+    __atomic_add_fetch(&pipeline->dropped_parts, 1, __ATOMIC_RELAXED);
+    return UR_DECODER_PROCESSING;
+  }
+  recent_seq_add(pipeline, seq_num);
+
+  if (__atomic_load_n(&pipeline->reducer_sleeping, __ATOMIC_SEQ_CST)) {
+    ur_mutex_lock(&pipeline->lock);
+    ur_cond_signal(&pipeline->wake);
+    ur_mutex_unlock(&pipeline->lock);
+  }
+  return UR_DECODER_PROCESSING;
+}
+
+ur_decoder_state_t ur_pipeline_get_state(const ur_pipeline_t *pipeline) {
+  if (!pipeline)
+    return UR_DECODER_ERROR_NULL_POINTER;
+  int state = __atomic_load_n(&pipeline->state, __ATOMIC_ACQUIRE);
+  if (state == PIPELINE_STATE_CLAIMED)
+    return UR_DECODER_PROCESSING;
+  return (ur_decoder_state_t)state;
+}
+
+ur_decoder_state_t ur_pipeline_wait(ur_pipeline_t *pipeline) {
+  if (!pipeline)
+    return UR_DECODER_ERROR_NULL_POINTER;
+
+  ur_mutex_lock(&pipeline->lock);
+  while (!(pipeline->reducer_sleeping && ring_is_empty(pipeline))) {
+    ur_cond_wait(&pipeline->idle, &pipeline->lock);
+  }
+  ur_mutex_unlock(&pipeline->lock);
+  return ur_pipeline_get_state(pipeline);
+}
+
+ur_result_t *ur_pipeline_get_result(ur_pipeline_t *pipeline) {
+  if (ur_pipeline_get_state(pipeline) != UR_DECODER_OK)
+    return NULL;
+  // The acquire load above orders these reads after the terminal publish;
+  // neither thread writes the result afterwards.
+  if (pipeline->single_result)
+    return pipeline->single_result;
+  return pipeline->decoder->result;
+}
+
+void ur_pipeline_get_progress(const ur_pipeline_t *pipeline, size_t *received,
+                              size_t *expected) {
+  if (received) {
+    *received = pipeline ? __atomic_load_n(&pipeline->received_parts,
+                                           __ATOMIC_RELAXED)
+                         : 0;
+  }
+  if (expected) {
+    *expected = pipeline ? __atomic_load_n(&pipeline->expected_parts,
+                                           __ATOMIC_RELAXED)
+                         : 0;
+  }
+}
+
+size_t ur_pipeline_dropped_count(const ur_pipeline_t *pipeline) {
+  return pipeline ? __atomic_load_n(&pipeline->dropped_parts, __ATOMIC_RELAXED)
+                  : 0;
+}
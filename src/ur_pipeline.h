@@ -0,0 +1,88 @@
+#ifndef UR_PIPELINE_H
+#define UR_PIPELINE_H
+
+#include "ur_decoder.h"
+#include "ur_export.h"
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * Pipelined UR decoder. ur_pipeline_submit() runs stage one on the calling
+ * (camera) thread: string parse, bytewords + CRC, CBOR header and duplicate
+ * filtering. Pre-validated fountain parts then cross a lock-free
+ * single-producer/single-consumer ring to a reducer thread that owns the
+ * fountain decoder, so the reduction cascade never blocks the producer.
+ *
+ * Submit from one thread only. The state, progress and result calls may
+ * be made from any thread.
+ */
+typedef struct ur_pipeline ur_pipeline_t;
+
+/**
+ * Create a pipeline and start its reducer thread
+ * @param ring_capacity Parts the ring can hold (rounded up to a power of
+ *                      two; 0 = default of 16)
+ * @return Pointer to pipeline or NULL on error
+ */
+UR_API ur_pipeline_t *ur_pipeline_new(size_t ring_capacity);
+
+/**
+ * Stop the reducer thread and free the pipeline (queued parts are dropped)
+ * @param pipeline Pointer to pipeline
+ */
+UR_API void ur_pipeline_free(ur_pipeline_t *pipeline);
+
+/**
+ * Parse and validate a length-delimited UR part and hand it to the reducer
+ * thread. Never blocks on reduction work: when the ring is full the part
+ * is dropped (and counted), which a rateless fountain stream tolerates.
+ * @param pipeline Pointer to pipeline
+ * @param part_str UR part bytes (ASCII)
+ * @param part_len Number of bytes in part_str
+ * @return UR_DECODER_PROCESSING if queued or filtered as a duplicate, the
+ *         terminal state once decoding has finished, or the transient error
+ *         state that rejected this part
+ */
+UR_API ur_decoder_state_t ur_pipeline_submit(ur_pipeline_t *pipeline,
+                                             const char *part_str,
+                                             size_t part_len);
+
+/**
+ * Get the decoding state as last published by the reducer thread
+ * @param pipeline Pointer to pipeline
+ * @return UR_DECODER_PROCESSING or a terminal state
+ */
+UR_API ur_decoder_state_t ur_pipeline_get_state(const ur_pipeline_t *pipeline);
+
+/**
+ * Block until the reducer thread has processed every queued part
+ * @param pipeline Pointer to pipeline
+ * @return Decoding state afterwards
+ */
+UR_API ur_decoder_state_t ur_pipeline_wait(ur_pipeline_t *pipeline);
+
+/**
+ * Get the result once ur_pipeline_get_state() returns UR_DECODER_OK
+ * @param pipeline Pointer to pipeline
+ * @return Result owned by the pipeline, or NULL
+ */
+UR_API ur_result_t *ur_pipeline_get_result(ur_pipeline_t *pipeline);
+
+/**
+ * Read the reducer's progress counters, published after every part
+ * @param pipeline Pointer to pipeline
+ * @param received Output unique pure fragments recovered (may be NULL)
+ * @param expected Output expected fragment count, 0 before the first part
+ *                 (may be NULL)
+ */
+UR_API void ur_pipeline_get_progress(const ur_pipeline_t *pipeline,
+                                     size_t *received, size_t *expected);
+
+/**
+ * Get the number of parts dropped because the ring was full
+ * @param pipeline Pointer to pipeline
+ * @return Dropped part count
+ */
+UR_API size_t ur_pipeline_dropped_count(const ur_pipeline_t *pipeline);
+
+#endif // UR_PIPELINE_H
@@ -0,0 +1,68 @@
+#ifndef UR_THREAD_H
+#define UR_THREAD_H
+
+// Minimal threading shim for the pipelined decoder (ur_pipeline.c): one
+// thread, one mutex, condition variables. The default maps onto pthreads;
+// a port without them (e.g. FreeRTOS) points UR_THREAD_IMPL at a header
+// that provides the same types and inline functions.
+
+#include <stdbool.h>
+
+#if defined(UR_THREAD_IMPL)
+#include UR_THREAD_IMPL
+#else
+
+#include <pthread.h>
+
+typedef pthread_t ur_thread_t;
+typedef pthread_mutex_t ur_mutex_t;
+typedef pthread_cond_t ur_cond_t;
+
+static inline bool ur_thread_start(ur_thread_t *thread, void *(*fn)(void *),
+                                   void *arg) {
+  return pthread_create(thread, NULL, fn, arg) == 0;
+}
+
+static inline void ur_thread_join(ur_thread_t thread) {
+  pthread_join(thread, NULL);
+}
+
+static inline bool ur_mutex_init(ur_mutex_t *mutex) {
+  return pthread_mutex_init(mutex, NULL) == 0;
+}
+
+static inline void ur_mutex_destroy(ur_mutex_t *mutex) {
+  pthread_mutex_destroy(mutex);
+}
+
+static inline void ur_mutex_lock(ur_mutex_t *mutex) {
+  pthread_mutex_lock(mutex);
+}
+
+static inline void ur_mutex_unlock(ur_mutex_t *mutex) {
+  pthread_mutex_unlock(mutex);
+}
+
+static inline bool ur_cond_init(ur_cond_t *cond) {
+  return pthread_cond_init(cond, NULL) == 0;
+}
+
+static inline void ur_cond_destroy(ur_cond_t *cond) {
+  pthread_cond_destroy(cond);
+}
+
+static inline void ur_cond_wait(ur_cond_t *cond, ur_mutex_t *mutex) {
+  pthread_cond_wait(cond, mutex);
+}
+
+static inline void ur_cond_signal(ur_cond_t *cond) {
+  pthread_cond_signal(cond);
+}
+
+static inline void ur_cond_broadcast(ur_cond_t *cond) {
+  pthread_cond_broadcast(cond);
+}
+
+#endif // UR_THREAD_IMPL
+
+#endif // UR_THREAD_H
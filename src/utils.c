@@ -285,15 +285,28 @@ bool is_ur_type(const char *type) {
 
 bool parse_ur_string(const char *ur_str, char **type, char ***components,
                      size_t *component_count) {
+  if (!ur_str)
+    return false;
+  return parse_ur_string_len(ur_str, strlen(ur_str), type, components,
+                             component_count);
+}
+
+bool parse_ur_string_len(const char *ur_str, size_t ur_len, char **type,
+                         char ***components, size_t *component_count) {
   if (!ur_str || !type || !components || !component_count)
     return false;
 
-  size_t len = strlen(ur_str);
-  char *lowered = safe_malloc(len + 1);
+  // A NUL inside the buffer would silently truncate the parse below.
+  if (memchr(ur_str, '\0', ur_len))
+    return false;
+
+  size_t len = ur_len;
+  char *lowered = safe_malloc_uninit(len + 1);
   if (!lowered)
     return false;
 
-  memcpy(lowered, ur_str, len + 1);
+  memcpy(lowered, ur_str, len);
+  lowered[len] = '\0';
   str_to_lower(lowered);
 
   if (len < 3 || lowered[0] != 'u' || lowered[1] != 'r' || lowered[2] != ':') {
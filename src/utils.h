@@ -1,6 +1,7 @@
 #ifndef UR_UTILS_H
 #define UR_UTILS_H
 
+#include "ur_export.h"
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
@@ -14,13 +15,13 @@
  * @param prefix Prefix to look for
  * @return true if str has prefix, false otherwise
  */
-bool str_has_prefix(const char *str, const char *prefix);
+UR_INTERNAL bool str_has_prefix(const char *str, const char *prefix);
 
 /**
  * Convert string to lowercase (in-place)
  * @param str String to convert
  */
-void str_to_lower(char *str);
+UR_INTERNAL void str_to_lower(char *str);
 
 /**
  * Split string by delimiter
@@ -30,15 +31,15 @@ void str_to_lower(char *str);
  * @param max_parts Maximum number of parts
  * @return Number of parts found
  */
-size_t str_split(const char *str, char delimiter, char **parts,
-                 size_t max_parts);
+UR_INTERNAL size_t str_split(const char *str, char delimiter, char **parts,
+                             size_t max_parts);
 
 /**
  * Check if string is a valid UR type
  * @param type Type string to validate
  * @return true if valid UR type, false otherwise
  */
-bool is_ur_type(const char *type);
+UR_INTERNAL bool is_ur_type(const char *type);
 
 /**
  * Parse UR string into components
@@ -48,8 +49,22 @@ bool is_ur_type(const char *type);
  * @param component_count Output component count
  * @return true on success, false on error
  */
-bool parse_ur_string(const char *ur_str, char **type, char ***components,
-                     size_t *component_count);
+UR_INTERNAL bool parse_ur_string(const char *ur_str, char **type,
+                                 char ***components, size_t *component_count);
+
+/**
+ * Parse a length-delimited UR string into components. The input need not
+ * be NUL-terminated; an embedded NUL within ur_len bytes is rejected.
+ * @param ur_str UR string bytes
+ * @param ur_len Number of bytes in ur_str
+ * @param type Output type string (allocated)
+ * @param components Output components array (allocated)
+ * @param component_count Output component count
+ * @return true on success, false on error
+ */
+UR_INTERNAL bool parse_ur_string_len(const char *ur_str, size_t ur_len,
+                                     char **type, char ***components,
+                                     size_t *component_count);
 
 /**
  * Parse sequence component (e.g., "1-5" -> seq_num=1, seq_len=5)
@@ -58,15 +73,15 @@ bool parse_ur_string(const char *ur_str, char **type, char ***components,
  * @param seq_len Output sequence length
  * @return true on success, false on error
  */
-bool parse_sequence_component(const char *seq_str, uint32_t *seq_num,
-                              size_t *seq_len);
+UR_INTERNAL bool parse_sequence_component(const char *seq_str,
+                                          uint32_t *seq_num, size_t *seq_len);
 
 /**
  * Free string array
  * @param strings Array of strings
  * @param count Number of strings
  */
-void free_string_array(char **strings, size_t count);
+UR_INTERNAL void free_string_array(char **strings, size_t count);
 
 // Memory utilities
 
@@ -75,7 +90,7 @@ void free_string_array(char **strings, size_t count);
  * @param size Size to allocate
  * @return Allocated memory or NULL on error
  */
-void *safe_malloc(size_t size);
+UR_INTERNAL void *safe_malloc(size_t size);
 
 /**
  * Safe malloc without zero initialization (for data buffers that will be
@@ -83,7 +98,7 @@ void *safe_malloc(size_t size);
  * @param size Size to allocate
  * @return Allocated memory or NULL on error
  */
-void *safe_malloc_uninit(size_t size);
+UR_INTERNAL void *safe_malloc_uninit(size_t size);
 
 /**
  * Wrapped realloc — a hook point for platform allocators, not a safer
@@ -104,14 +119,14 @@ void *safe_malloc_uninit(size_t size);
  * @param size New size (must be > 0; passing 0 is implementation-defined)
  * @return New pointer on success, NULL on failure (old pointer unchanged)
  */
-void *safe_realloc(void *ptr, size_t size);
+UR_INTERNAL void *safe_realloc(void *ptr, size_t size);
 
 /**
  * Safe string duplication
  * @param str String to duplicate
  * @return Duplicated string or NULL on error
  */
-char *safe_strdup(const char *str);
+UR_INTERNAL char *safe_strdup(const char *str);
 
 /**
  * Free a pointer and null it out. Expands the argument once; pass a
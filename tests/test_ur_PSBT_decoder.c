@@ -117,6 +117,19 @@ static bool test_file(const char *filepath) {
               printf("✅ PASS - PSBT bytes match expected\n");
               success = true;
             }
+
+            // Zero-copy view must point at the same payload
+            size_t view_len = 0;
+            const uint8_t *view =
+                psbt_payload_from_cbor(cbor_data, cbor_len, &view_len);
+            bool in_place = view && view > cbor_data &&
+                            view + view_len == cbor_data + cbor_len;
+            if (!in_place ||
+                !assert_bytes_equal(expected_bytes, expected_len, view,
+                                    view_len, "PSBT payload view")) {
+              fprintf(stderr, "❌ psbt_payload_from_cbor view mismatch\n");
+              success = false;
+            }
           } else {
             fprintf(stderr, "❌ Failed to get PSBT data\n");
           }
@@ -135,6 +148,19 @@ static bool test_file(const char *filepath) {
     printf("❌ Decoding failed or incomplete\n");
   }
 
+  // Ownership transfer: the decoder drops its CBOR reference
+  if (success) {
+    size_t taken_len = 0;
+    uint8_t *taken = ur_decoder_take_result_cbor(decoder, &taken_len);
+    ur_result_t *after = ur_decoder_get_result(decoder);
+    if (!taken || taken_len == 0 || !after || after->cbor_data ||
+        ur_decoder_take_result_cbor(decoder, &taken_len) != NULL) {
+      fprintf(stderr, "❌ take_result_cbor did not transfer ownership\n");
+      success = false;
+    }
+    free(taken);
+  }
+
   ur_decoder_free(decoder);
   free_fragments(fragments, fragment_count);
   free(expected_bytes);
@@ -1,3 +1,4 @@
+#define _POSIX_C_SOURCE 200809L
 /*
  * test_ur_envelope_api.c
  *
@@ -8,18 +9,369 @@
  *  - Single-part encoding: ur_encoder_is_complete() must become true after
  *    the single part has been emitted, and the emitted part must round-trip
  *    through the decoder.
+ *  - ur_decoder_receive_part_len(): decoding from length-delimited buffers
+ *    with no NUL terminator (trailing bytes past the length are ignored).
+ *  - ur_decoder_solved_bitmap() / ur_decoder_get_stats(): the bitmap's
+ *    popcount and the stats track received_parts_count frame by frame.
+ *  - ur_decoder_enqueue_part() / ur_decoder_step(): queuing every frame and
+ *    stepping with a minimal budget decodes the same message as
+ *    receive_part(), one queued part per step.
+ *  - ur_encoder_next_part_into(): renders the same parts as
+ *    ur_encoder_next_part() into one reused buffer, and a short buffer fails
+ *    without consuming a sequence number.
+ *  - Fragment count limit: the encoder accepts a message of exactly
+ *    UR_INDEX_MAX fragments and rejects one that needs more.
+ *  - ur_encoder_new_from_source(): a chunked read callback and a mapped
+ *    file emit the same parts as ur_encoder_new() over the same bytes, and
+ *    a failing source is closed and rejected.
+ *  - ur_decoder_set_output_sink(): multi-part messages are reassembled
+ *    in a sink, each byte written once, with a NULL cbor_data result; a
+ *    file source and file sink carry a message past UR_MAX_MESSAGE_LEN
+ *    that the default cap rejects.
+ *  - ur_decoder_reset(): one decoder, reset between messages (kept across
+ *    files, so seq_len and fragment length change), after an abandoned
+ *    half scan and with a shrink threshold, decodes each message as a
+ *    fresh decoder does.
  */
 
+#include "../src/crc32.h"
 #include "../src/ur_decoder.h"
 #include "../src/ur_encoder.h"
+#include "../src/ur_file.h"
 #include "test_harness.h"
 #include "test_utils.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#if UR_FILE_SOURCE
+#include <unistd.h>
+#endif
 
 #define TEST_CASES_DIR "tests/test_cases/bytes"
 
+// Bitmap and stats must agree with the scalar counters.
+static bool check_bitmap_and_stats(ur_decoder_t *decoder) {
+  uint8_t bitmap[256];
+  size_t bitmap_len = ur_decoder_solved_bitmap(decoder, NULL, 0);
+  size_t expected = ur_decoder_expected_part_count(decoder);
+  if (bitmap_len != (expected + 7) / 8 || bitmap_len > sizeof(bitmap) ||
+      ur_decoder_solved_bitmap(decoder, bitmap, sizeof(bitmap)) !=
+          bitmap_len) {
+    fprintf(stderr, "❌ Bitmap size %zu for %zu parts\n", bitmap_len,
+            expected);
+    return false;
+  }
+
+  size_t solved = 0;
+  for (size_t i = 0; i < expected; i++) {
+    solved += (bitmap[i / 8] >> (i % 8)) & 1;
+  }
+
+  ur_decoder_stats_t stats;
+  ur_decoder_get_stats(decoder, &stats);
+  if (solved != ur_decoder_received_parts_count(decoder) ||
+      stats.received_parts_count != solved ||
+      stats.expected_part_count != expected ||
+      stats.processed_parts_count !=
+          ur_decoder_processed_parts_count(decoder)) {
+    fprintf(stderr, "❌ Bitmap/stats disagree with counters (%zu solved)\n",
+            solved);
+    return false;
+  }
+  return true;
+}
+
+// Feed every frame through ur_decoder_receive_part_len() from a buffer that
+// has no NUL terminator and junk past the given length, as a camera QR
+// decoder would hand them over.
+static bool test_length_delimited(char **fragments, int fragment_count) {
+  ur_decoder_t *decoder = ur_decoder_new();
+  if (!decoder)
+    return false;
+
+  ur_decoder_state_t state = UR_DECODER_PROCESSING;
+  for (int i = 0; i < fragment_count && !ur_decoder_state_is_terminal(state);
+       i++) {
+    size_t len = strlen(fragments[i]);
+    char *frame = malloc(len + 8);
+    if (!frame)
+      break;
+    memcpy(frame, fragments[i], len);
+    memset(frame + len, 'x', 8);
+    state = ur_decoder_receive_part_len(decoder, frame, len);
+    free(frame);
+  }
+
+  bool ok = state == UR_DECODER_OK;
+  if (!ok)
+    fprintf(stderr, "❌ Length-delimited decode ended in state %d\n", state);
+  ur_decoder_free(decoder);
+  return ok;
+}
+
+// Queue every frame, then drain with budget 0 (one queued part per step).
+// The result must match the receive_part() decode.
+static bool test_enqueue_and_step(char **fragments, int fragment_count,
+                                  const ur_result_t *expected) {
+  ur_decoder_t *decoder = ur_decoder_new();
+  if (!decoder)
+    return false;
+
+  bool ok = true;
+  ur_decoder_state_t state = UR_DECODER_PROCESSING;
+  for (int i = 0; i < fragment_count && !ur_decoder_state_is_terminal(state);
+       i++) {
+    state = ur_decoder_enqueue_part(decoder, fragments[i]);
+    if (fragment_count > 1 && ur_decoder_state_is_terminal(state)) {
+      fprintf(stderr, "❌ enqueue_part completed a multi-part decode\n");
+      ok = false;
+    }
+  }
+
+  int steps = 0;
+  while (ok && ur_decoder_step(decoder, 0)) {
+    steps++;
+  }
+
+  ur_result_t *result = ur_decoder_get_result(decoder);
+  if (ok && (!result || result->cbor_len != expected->cbor_len ||
+             memcmp(result->cbor_data, expected->cbor_data,
+                    expected->cbor_len))) {
+    fprintf(stderr, "❌ Stepped decode ended in state %d after %d steps\n",
+            ur_decoder_get_state(decoder), steps);
+    ok = false;
+  }
+  if (ok && ur_decoder_step(decoder, 0)) {
+    fprintf(stderr, "❌ Terminal decoder reports remaining work\n");
+    ok = false;
+  }
+
+  ur_decoder_free(decoder);
+  return ok;
+}
+
+// In-memory output sink that counts what the decoder writes
+typedef struct {
+  uint8_t *buf;
+  size_t len;
+  size_t bytes_written;
+  int closes;
+} memory_sink_t;
+
+static bool memory_sink_begin(void *ctx, size_t message_len) {
+  memory_sink_t *sink = (memory_sink_t *)ctx;
+  free(sink->buf);
+  sink->buf = calloc(message_len, 1);
+  sink->len = message_len;
+  return sink->buf != NULL;
+}
+
+static bool memory_sink_write(void *ctx, size_t offset, const uint8_t *buf,
+                              size_t len) {
+  memory_sink_t *sink = (memory_sink_t *)ctx;
+  if (offset + len > sink->len)
+    return false;
+  memcpy(sink->buf + offset, buf, len);
+  sink->bytes_written += len;
+  return true;
+}
+
+static bool memory_sink_read(void *ctx, size_t offset, uint8_t *buf,
+                             size_t len) {
+  memory_sink_t *sink = (memory_sink_t *)ctx;
+  if (offset + len > sink->len)
+    return false;
+  memcpy(buf, sink->buf + offset, len);
+  return true;
+}
+
+static void memory_sink_close(void *ctx) { ((memory_sink_t *)ctx)->closes++; }
+
+// Collects in-order prefix deliveries; any call that does not continue at
+// the end of the previous one is recorded as a gap
+typedef struct {
+  uint8_t *buf;
+  size_t cap;
+  size_t len;
+  bool gap;
+} prefix_collector_t;
+
+static void collect_prefix(void *ctx, size_t offset, const uint8_t *data,
+                           size_t len) {
+  prefix_collector_t *c = (prefix_collector_t *)ctx;
+  if (offset != c->len || len == 0 || len > c->cap - c->len) {
+    c->gap = true;
+    return;
+  }
+  memcpy(c->buf + c->len, data, len);
+  c->len += len;
+}
+
+static bool check_prefix(const prefix_collector_t *c,
+                         const ur_result_t *expected) {
+  if (c->gap || c->len != expected->cbor_len ||
+      memcmp(c->buf, expected->cbor_data, c->len) != 0) {
+    fprintf(stderr, "❌ Prefix delivery %s (%zu of %zu bytes)\n",
+            c->gap ? "has a gap" : "is wrong", c->len, expected->cbor_len);
+    return false;
+  }
+  return true;
+}
+
+// In-order delivery: the callback, set after the first part, must first
+// catch up on the prefix already solved and then see the whole message as
+// consecutive chunks, starting before the decoder completes.
+static bool test_prefix_delivery(char **fragments, int fragment_count,
+                                 const ur_result_t *expected) {
+  prefix_collector_t collector = {malloc(expected->cbor_len),
+                                  expected->cbor_len, 0, false};
+  ur_decoder_t *decoder = ur_decoder_new();
+  bool ok = decoder && collector.buf;
+
+  ur_decoder_state_t state = UR_DECODER_PROCESSING;
+  size_t before_ok = 0;
+  for (int i = 0; ok && i < fragment_count; i++) {
+    state = ur_decoder_receive_part(decoder, fragments[i]);
+    if (i == 0) {
+      ur_decoder_set_prefix_callback(decoder, collect_prefix, &collector);
+    }
+    if (ur_decoder_state_is_terminal(state))
+      break;
+    before_ok = collector.len;
+  }
+
+  ok = ok && state == UR_DECODER_OK && check_prefix(&collector, expected);
+  if (ok && fragment_count > 1 && before_ok == 0) {
+    fprintf(stderr, "❌ Nothing delivered before the decoder completed\n");
+    ok = false;
+  }
+
+  ur_decoder_free(decoder);
+  free(collector.buf);
+  return ok;
+}
+
+// Decode into a memory sink: the message must land there, each byte
+// written exactly once, with the result carrying only its length.
+static bool test_output_sink(char **fragments, int fragment_count,
+                             const ur_result_t *expected) {
+  memory_sink_t store = {0};
+  fountain_sink_t sink = {memory_sink_begin, memory_sink_write,
+                          memory_sink_read, memory_sink_close, &store};
+  prefix_collector_t collector = {malloc(expected->cbor_len),
+                                  expected->cbor_len, 0, false};
+  ur_decoder_t *decoder = ur_decoder_new();
+  bool ok = decoder && ur_decoder_set_output_sink(decoder, &sink, 0) &&
+            collector.buf;
+  if (ok) {
+    ur_decoder_set_prefix_callback(decoder, collect_prefix, &collector);
+  }
+
+  ur_decoder_state_t state = UR_DECODER_PROCESSING;
+  for (int i = 0; ok && i < fragment_count; i++) {
+    state = ur_decoder_receive_part(decoder, fragments[i]);
+    if (ur_decoder_state_is_terminal(state))
+      break;
+  }
+
+  ur_result_t *result = ur_decoder_get_result(decoder);
+  if (ok && (!result || result->cbor_len != expected->cbor_len)) {
+    fprintf(stderr, "❌ Sink decode ended in state %d\n", state);
+    ok = false;
+  } else if (ok && result->cbor_data) {
+    // Single-part URs keep their payload in memory
+    ok = store.bytes_written == 0 &&
+         memcmp(result->cbor_data, expected->cbor_data, expected->cbor_len) ==
+             0;
+  } else if (ok) {
+    ok = store.len == expected->cbor_len &&
+         store.bytes_written == expected->cbor_len &&
+         memcmp(store.buf, expected->cbor_data, expected->cbor_len) == 0;
+  }
+  if (!ok) {
+    fprintf(stderr, "❌ Sink holds the wrong message (%zu bytes written)\n",
+            store.bytes_written);
+  }
+  ok = ok && check_prefix(&collector, expected);
+
+  // A second sink is refused once parts have arrived, and closed
+  memory_sink_t late = {0};
+  fountain_sink_t late_sink = {memory_sink_begin, memory_sink_write,
+                               memory_sink_read, memory_sink_close, &late};
+  if (ok && (ur_decoder_set_output_sink(decoder, &late_sink, 0) ||
+             late.closes != 1)) {
+    fprintf(stderr, "❌ Output sink accepted after the first part\n");
+    ok = false;
+  }
+
+  ur_decoder_free(decoder);
+  if (ok && store.closes != 1) {
+    fprintf(stderr, "❌ Output sink closed %d times\n", store.closes);
+    ok = false;
+  }
+  free(store.buf);
+  free(collector.buf);
+  return ok;
+}
+
+// Shared by every file, so each reset follows a different message
+static ur_decoder_t *reused_decoder;
+
+static bool decode_after_reset(char **fragments, int stop_after,
+                               size_t shrink_threshold) {
+  ur_decoder_reset(reused_decoder, shrink_threshold);
+  if (ur_decoder_get_state(reused_decoder) != UR_DECODER_PROCESSING ||
+      ur_decoder_get_result(reused_decoder) ||
+      ur_decoder_received_parts_count(reused_decoder) != 0 ||
+      ur_decoder_expected_part_count(reused_decoder) != 0) {
+    fprintf(stderr, "❌ Reset decoder is not fresh\n");
+    return false;
+  }
+
+  ur_decoder_state_t state = UR_DECODER_PROCESSING;
+  for (int i = 0; i < stop_after && !ur_decoder_state_is_terminal(state);
+       i++) {
+    state = ur_decoder_receive_part(reused_decoder, fragments[i]);
+  }
+  return true;
+}
+
+// Decode with the reused decoder: a full scan, an abandoned half scan
+// followed by a full one, then a full scan after a shrinking reset.
+static bool test_reset(char **fragments, int fragment_count,
+                       const ur_result_t *expected) {
+  if (!reused_decoder) {
+    reused_decoder = ur_decoder_new();
+    if (!reused_decoder)
+      return false;
+  }
+
+  const struct {
+    int stop_after;
+    size_t shrink_threshold;
+  } scans[] = {{fragment_count, 0},
+               {fragment_count / 2, 0},
+               {fragment_count, 0},
+               {fragment_count, 1}};
+  for (size_t s = 0; s < sizeof(scans) / sizeof(scans[0]); s++) {
+    if (!decode_after_reset(fragments, scans[s].stop_after,
+                            scans[s].shrink_threshold))
+      return false;
+    if (scans[s].stop_after < fragment_count)
+      continue;
+
+    ur_result_t *result = ur_decoder_get_result(reused_decoder);
+    if (!result || strcmp(result->type, expected->type) != 0 ||
+        result->cbor_len != expected->cbor_len ||
+        memcmp(result->cbor_data, expected->cbor_data, expected->cbor_len)) {
+      fprintf(stderr, "❌ Scan %zu after reset ended in state %d\n", s,
+              ur_decoder_get_state(reused_decoder));
+      return false;
+    }
+  }
+  return true;
+}
+
 static bool test_file(const char *filepath) {
   printf("\n=== Testing file: %s ===\n", filepath);
 
@@ -64,6 +416,10 @@ static bool test_file(const char *filepath) {
     }
     prev = received;
 
+    if (ok && !check_bitmap_and_stats(decoder)) {
+      ok = false;
+    }
+
     // A duplicate of a frame already seen must not change the count
     if (ok &&
         !ur_decoder_state_is_error(
@@ -88,9 +444,46 @@ static bool test_file(const char *filepath) {
             ur_decoder_expected_part_count(decoder));
     ok = false;
   }
+  if (ok && !check_bitmap_and_stats(decoder)) {
+    ok = false;
+  }
   if (ok) {
     printf("✅ PASS - received-count invariants held (%zu parts)\n", prev);
   }
+  if (ok && !test_length_delimited(fragments, fragment_count)) {
+    ok = false;
+  }
+  if (ok) {
+    printf("✅ PASS - length-delimited frames decode\n");
+  }
+  if (ok && !test_enqueue_and_step(fragments, fragment_count,
+                                   ur_decoder_get_result(decoder))) {
+    ok = false;
+  }
+  if (ok) {
+    printf("✅ PASS - enqueue_part + step decode\n");
+  }
+  if (ok && !test_prefix_delivery(fragments, fragment_count,
+                                  ur_decoder_get_result(decoder))) {
+    ok = false;
+  }
+  if (ok) {
+    printf("✅ PASS - in-order prefix delivery\n");
+  }
+  if (ok && !test_output_sink(fragments, fragment_count,
+                              ur_decoder_get_result(decoder))) {
+    ok = false;
+  }
+  if (ok) {
+    printf("✅ PASS - decode into an output sink\n");
+  }
+  if (ok && !test_reset(fragments, fragment_count,
+                        ur_decoder_get_result(decoder))) {
+    ok = false;
+  }
+  if (ok) {
+    printf("✅ PASS - decode after reset\n");
+  }
 
   ur_decoder_free(decoder);
   free_fragments(fragments, fragment_count);
@@ -166,6 +559,452 @@ static bool test_single_part_encoder(void) {
   return ok;
 }
 
+// Compare next_part_into() against next_part() on twin encoders.
+static bool check_next_part_into(const uint8_t *cbor, size_t cbor_len,
+                                 size_t max_fragment_len, int parts) {
+  ur_encoder_t *reference =
+      ur_encoder_new("bytes", cbor, cbor_len, max_fragment_len, 0, 10);
+  ur_encoder_t *encoder =
+      ur_encoder_new("bytes", cbor, cbor_len, max_fragment_len, 0, 10);
+  size_t buf_len = ur_encoder_part_buffer_len(encoder);
+  char *buf = malloc(buf_len ? buf_len : 1);
+  bool ok = reference && encoder && buf && buf_len > 0;
+
+  // One byte short must fail and leave the encoder where it was
+  size_t part_len = 0;
+  if (ok && ur_encoder_next_part_into(encoder, buf, buf_len - 1, &part_len)) {
+    fprintf(stderr, "❌ next_part_into accepted a short buffer\n");
+    ok = false;
+  }
+
+  for (int i = 0; i < parts && ok; i++) {
+    char *expected = NULL;
+    if (!ur_encoder_next_part(reference, &expected) ||
+        !ur_encoder_next_part_into(encoder, buf, buf_len, &part_len) ||
+        part_len != strlen(expected) || strcmp(buf, expected)) {
+      fprintf(stderr, "❌ next_part_into differs from next_part at %d\n", i);
+      ok = false;
+    }
+    free(expected);
+  }
+
+  free(buf);
+  ur_encoder_free(encoder);
+  ur_encoder_free(reference);
+  return ok;
+}
+
+static bool test_next_part_into(void) {
+  printf("\n=== Testing next_part_into ===\n");
+
+  uint8_t cbor[603];
+  cbor[0] = 0x59; // bytes(600)
+  cbor[1] = 0x02;
+  cbor[2] = 0x58;
+  for (size_t i = 3; i < sizeof(cbor); i++) {
+    cbor[i] = (uint8_t)(i * 37 + 11);
+  }
+
+  // Multi-part (past seq_len into mixed parts) and single-part
+  bool ok = check_next_part_into(cbor, sizeof(cbor), 100, 40) &&
+            check_next_part_into(cbor, 20, 100, 3);
+  if (ok) {
+    printf("✅ PASS - next_part_into matches next_part\n");
+  }
+  return ok;
+}
+
+// A message kept as fixed-size chunks, as a flash or paged store would
+#define SOURCE_CHUNK_LEN 64
+
+typedef struct {
+  const uint8_t *chunks[16];
+  size_t len;
+  int reads_left; // fail once exhausted (-1 = never)
+  int closes;
+} chunked_source_t;
+
+static bool chunked_read(void *ctx, size_t offset, uint8_t *buf, size_t len) {
+  chunked_source_t *src = (chunked_source_t *)ctx;
+  if (src->reads_left == 0 || offset + len > src->len)
+    return false;
+  if (src->reads_left > 0)
+    src->reads_left--;
+  while (len > 0) {
+    size_t in_chunk = SOURCE_CHUNK_LEN - offset % SOURCE_CHUNK_LEN;
+    size_t n = len < in_chunk ? len : in_chunk;
+    const uint8_t *chunk = src->chunks[offset / SOURCE_CHUNK_LEN];
+    memcpy(buf, chunk + offset % SOURCE_CHUNK_LEN, n);
+    buf += n;
+    offset += n;
+    len -= n;
+  }
+  return true;
+}
+
+static void chunked_close(void *ctx) { ((chunked_source_t *)ctx)->closes++; }
+
+// Compare the parts of a source-backed encoder against ur_encoder_new().
+static bool check_source_parts(ur_encoder_t *encoder, const uint8_t *cbor,
+                               size_t cbor_len, size_t max_fragment_len,
+                               int parts) {
+  ur_encoder_t *reference =
+      ur_encoder_new("bytes", cbor, cbor_len, max_fragment_len, 0, 10);
+  bool ok = reference && encoder &&
+            ur_encoder_seq_len(encoder) == ur_encoder_seq_len(reference) &&
+            encoder->fountain_encoder->checksum ==
+                reference->fountain_encoder->checksum;
+
+  for (int i = 0; i < parts && ok; i++) {
+    char *expected = NULL, *part = NULL;
+    if (!ur_encoder_next_part(reference, &expected) ||
+        !ur_encoder_next_part(encoder, &part) || strcmp(part, expected)) {
+      fprintf(stderr, "❌ Source encoder differs from buffer at part %d\n",
+              i);
+      ok = false;
+    }
+    free(expected);
+    free(part);
+  }
+
+  ur_encoder_free(reference);
+  return ok;
+}
+
+static bool test_source_encoder(void) {
+  printf("\n=== Testing source-backed encoder ===\n");
+
+  uint8_t cbor[603];
+  cbor[0] = 0x59; // bytes(600)
+  cbor[1] = 0x02;
+  cbor[2] = 0x58;
+  for (size_t i = 3; i < sizeof(cbor); i++) {
+    cbor[i] = (uint8_t)(i * 53 + 7);
+  }
+
+  // Streamed checksum over uneven pieces
+  uint32_t crc = 0;
+  for (size_t off = 0; off < sizeof(cbor); off += 37) {
+    size_t n = sizeof(cbor) - off < 37 ? sizeof(cbor) - off : 37;
+    crc = crc32_update(crc, cbor + off, n);
+  }
+  bool ok = crc == crc32_calculate(cbor, sizeof(cbor));
+  if (!ok) {
+    fprintf(stderr, "❌ crc32_update differs from crc32_calculate\n");
+  }
+
+  chunked_source_t store = {{NULL}, sizeof(cbor), -1, 0};
+  for (size_t c = 0; c * SOURCE_CHUNK_LEN < sizeof(cbor); c++) {
+    store.chunks[c] = cbor + c * SOURCE_CHUNK_LEN;
+  }
+  fountain_source_t source = {chunked_read, chunked_close, &store};
+
+  // Multi-part (fragments straddle chunks; mixed parts past seq_len) and
+  // single-part
+  ur_encoder_t *encoder =
+      ur_encoder_new_from_source("bytes", &source, sizeof(cbor), 100, 0, 10);
+  ok = ok && check_source_parts(encoder, cbor, sizeof(cbor), 100, 40);
+  ur_encoder_free(encoder);
+  store.len = 20;
+  encoder = ur_encoder_new_from_source("bytes", &source, 20, 100, 0, 10);
+  ok = ok && check_source_parts(encoder, cbor, 20, 100, 3);
+  ur_encoder_free(encoder);
+  if (ok && store.closes != 2) {
+    fprintf(stderr, "❌ Source closed %d times for 2 encoders\n",
+            store.closes);
+    ok = false;
+  }
+
+  // A read failing during the checksum pass rejects (and closes) the source
+  store.len = sizeof(cbor);
+  store.reads_left = 2;
+  store.closes = 0;
+  encoder =
+      ur_encoder_new_from_source("bytes", &source, sizeof(cbor), 100, 0, 10);
+  if (ok && (encoder || store.closes != 1)) {
+    fprintf(stderr, "❌ Failing source: encoder %s, closed %d times\n",
+            encoder ? "created" : "rejected", store.closes);
+    ok = false;
+  }
+  ur_encoder_free(encoder);
+
+#if UR_FILE_SOURCE
+  FILE *file = tmpfile();
+  size_t file_len = 0;
+  bool mapped = file &&
+                fwrite(cbor, 1, sizeof(cbor), file) == sizeof(cbor) &&
+                fflush(file) == 0 &&
+                ur_file_source_from_fd(fileno(file), &source, &file_len);
+  if (file) {
+    fclose(file); // the mapping outlives the descriptor
+  }
+  if (mapped && file_len != sizeof(cbor)) {
+    source.close(source.ctx);
+    mapped = false;
+  }
+  if (mapped) {
+    encoder =
+        ur_encoder_new_from_source("bytes", &source, file_len, 100, 0, 10);
+    ok = ok && check_source_parts(encoder, cbor, sizeof(cbor), 100, 40);
+    ur_encoder_free(encoder);
+  } else {
+    ok = false;
+    fprintf(stderr, "❌ Could not map a file source\n");
+  }
+#endif
+
+  if (ok) {
+    printf("✅ PASS - source-backed encoder matches buffer encoder\n");
+  }
+  return ok;
+}
+
+#if UR_FILE_SOURCE
+// Feed every part of encoder to decoder until it is terminal
+static ur_decoder_state_t feed_parts(ur_encoder_t *encoder,
+                                     ur_decoder_t *decoder, size_t max_parts) {
+  ur_decoder_state_t state = UR_DECODER_PROCESSING;
+  for (size_t i = 0; i < max_parts && !ur_decoder_state_is_terminal(state);
+       i++) {
+    char *part = NULL;
+    if (!ur_encoder_next_part(encoder, &part))
+      return UR_DECODER_ERROR_MEMORY;
+    state = ur_decoder_receive_part(decoder, part);
+    free(part);
+  }
+  return state;
+}
+
+// File to file, past UR_MAX_MESSAGE_LEN: a default decoder rejects the
+// message, one with a file sink and a raised cap reassembles it on disk.
+static bool test_large_file_roundtrip(void) {
+  printf("\n=== Testing file sink past the message cap ===\n");
+
+  const size_t len = 300 * 1024;
+  char in_path[] = "/tmp/ur_in_XXXXXX";
+  char out_path[] = "/tmp/ur_out_XXXXXX";
+  int in_fd = mkstemp(in_path);
+  int out_fd = mkstemp(out_path);
+  uint8_t *message = malloc(len);
+  uint8_t *decoded = malloc(len);
+  bool ok = in_fd >= 0 && out_fd >= 0 && message && decoded;
+  for (size_t i = 0; ok && i < len; i++) {
+    message[i] = (uint8_t)(i * 131 + (i >> 9));
+  }
+  ok = ok && write(in_fd, message, len) == (ssize_t)len;
+
+  // One source per encoder: the encoder closes it
+  fountain_source_t source;
+  size_t source_len = 0;
+  ur_encoder_t *encoder = NULL;
+  ur_decoder_t *decoder = ur_decoder_new();
+  if (ok && ur_file_source_open(in_path, &source, &source_len)) {
+    encoder =
+        ur_encoder_new_from_source("bytes", &source, source_len, 1000, 0, 10);
+  }
+  ok = ok && encoder && decoder &&
+       feed_parts(encoder, decoder, 1) == UR_DECODER_ERROR_INVALID_FRAGMENT;
+  if (!ok) {
+    fprintf(stderr, "❌ Default cap accepted a %zu-byte message\n", len);
+  }
+  ur_encoder_free(encoder);
+  ur_decoder_free(decoder);
+
+  fountain_sink_t sink;
+  encoder = NULL;
+  decoder = ur_decoder_new();
+  if (ok && ur_file_source_open(in_path, &source, &source_len)) {
+    encoder =
+        ur_encoder_new_from_source("bytes", &source, source_len, 1000, 0, 10);
+  }
+  ok = ok && encoder && decoder && ur_file_sink_open(out_path, &sink) &&
+       ur_decoder_set_output_sink(decoder, &sink, 1024 * 1024);
+  ur_decoder_state_t state =
+      ok ? feed_parts(encoder, decoder, 4 * len / 1000)
+         : UR_DECODER_ERROR_NULL_POINTER;
+  ur_result_t *result = ur_decoder_get_result(decoder);
+  if (ok && (state != UR_DECODER_OK || !result || result->cbor_data ||
+             result->cbor_len != len)) {
+    fprintf(stderr, "❌ File sink decode ended in state %d\n", state);
+    ok = false;
+  }
+  ur_encoder_free(encoder);
+  ur_decoder_free(decoder); // unmaps the output file
+
+  ok = ok && lseek(out_fd, 0, SEEK_END) == (off_t)len &&
+       lseek(out_fd, 0, SEEK_SET) == 0 &&
+       read(out_fd, decoded, len) == (ssize_t)len &&
+       memcmp(decoded, message, len) == 0;
+  if (ok) {
+    printf("✅ PASS - %zu-byte message reassembled in a file\n", len);
+  } else {
+    fprintf(stderr, "❌ Output file differs from the input\n");
+  }
+
+  if (in_fd >= 0) {
+    close(in_fd);
+    unlink(in_path);
+  }
+  if (out_fd >= 0) {
+    close(out_fd);
+    unlink(out_path);
+  }
+  free(message);
+  free(decoded);
+  return ok;
+}
+
+// A file sink begun again for a shorter message is cut to that length
+static bool test_file_sink_resize(void) {
+  printf("\n=== Testing file sink resize ===\n");
+
+  char path[] = "/tmp/ur_sink_XXXXXX";
+  int fd = mkstemp(path);
+  const uint8_t byte = 0x5a;
+  uint8_t back = 0;
+  fountain_sink_t sink;
+  bool ok = fd >= 0 && ur_file_sink_open(path, &sink);
+  if (ok) {
+    ok = sink.begin(sink.ctx, 4096) &&
+         sink.write(sink.ctx, 4095, &byte, 1) && sink.begin(sink.ctx, 100) &&
+         lseek(fd, 0, SEEK_END) == 100 &&
+         !sink.write(sink.ctx, 100, &byte, 1) &&
+         sink.write(sink.ctx, 99, &byte, 1) &&
+         sink.read(sink.ctx, 99, &back, 1) && back == byte;
+    sink.close(sink.ctx);
+  }
+  if (ok) {
+    printf("✅ PASS - file shrinks to the new message length\n");
+  } else {
+    fprintf(stderr, "❌ File sink kept the earlier message's length\n");
+  }
+
+  if (fd >= 0) {
+    close(fd);
+    unlink(path);
+  }
+  return ok;
+}
+#endif
+
+static bool test_fragment_count_limit(void) {
+  printf("\n=== Testing fragment count limit ===\n");
+
+#if UR_INDEX_BITS == 16
+  // One-byte fragments, so the message length is the fragment count
+  size_t len = (size_t)UR_INDEX_MAX + 1;
+  uint8_t *cbor = calloc(len, 1);
+  if (!cbor)
+    return false;
+
+  ur_encoder_t *at_limit = ur_encoder_new("bytes", cbor, len - 1, 1, 0, 1);
+  ur_encoder_t *over_limit = ur_encoder_new("bytes", cbor, len, 1, 0, 1);
+  bool ok = at_limit != NULL && over_limit == NULL;
+  if (!ok) {
+    fprintf(stderr, "❌ Encoder limit: %s at UR_INDEX_MAX, %s past it\n",
+            at_limit ? "accepted" : "rejected",
+            over_limit ? "accepted" : "rejected");
+  }
+  ur_encoder_free(at_limit);
+  ur_encoder_free(over_limit);
+  free(cbor);
+  if (!ok)
+    return false;
+#endif
+
+  printf("✅ PASS - encoder rejects more than UR_INDEX_MAX fragments\n");
+  return true;
+}
+
+#define CACHE_MESSAGE_LEN 102 // bytes(100): six 20-byte fragments
+
+// A bytes(100) message filled with tag
+static void cache_message(uint8_t *cbor, uint8_t tag) {
+  cbor[0] = 0x58;
+  cbor[1] = CACHE_MESSAGE_LEN - 2;
+  memset(cbor + 2, tag, CACHE_MESSAGE_LEN - 2);
+}
+
+// Reset decoder and scan the message from seq_num first_seq_num on. Returns
+// the frames it took to decode, 0 on failure or a wrong result.
+static int frames_to_decode(ur_decoder_t *decoder, uint8_t tag,
+                            uint32_t first_seq_num) {
+  uint8_t cbor[CACHE_MESSAGE_LEN];
+  cache_message(cbor, tag);
+  ur_encoder_t *encoder = ur_encoder_new("bytes", cbor, sizeof(cbor), 20,
+                                         first_seq_num, 20);
+  ur_decoder_reset(decoder, 0);
+
+  int frames = 0;
+  ur_decoder_state_t state = UR_DECODER_PROCESSING;
+  while (encoder && frames < 200 && state == UR_DECODER_PROCESSING) {
+    char *part = NULL;
+    if (!ur_encoder_next_part(encoder, &part))
+      break;
+    state = ur_decoder_receive_part(decoder, part);
+    frames++;
+    free(part);
+  }
+  ur_encoder_free(encoder);
+
+  ur_result_t *result = ur_decoder_get_result(decoder);
+  if (!result || result->cbor_len != sizeof(cbor) ||
+      memcmp(result->cbor_data, cbor, sizeof(cbor)) != 0)
+    return 0;
+  return frames;
+}
+
+// Recently-decoded cache: a rescan finishes on its first frame, pure or
+// mixed; the least recently used message goes first, oversized ones are
+// never held, and the cache survives decoder resets.
+static bool test_decode_cache(void) {
+  printf("\n=== Testing recently-decoded cache ===\n");
+
+  ur_decoder_cache_t *cache = ur_decoder_cache_new(2, 4096);
+  ur_decoder_t *decoder = ur_decoder_new();
+  bool ok = cache && decoder;
+  if (ok) {
+    ur_decoder_set_cache(decoder, cache);
+  }
+
+  ok = ok && frames_to_decode(decoder, 'A', 0) > 1 &&
+       frames_to_decode(decoder, 'B', 0) > 1 &&
+       frames_to_decode(decoder, 'A', 0) == 1 &&
+       frames_to_decode(decoder, 'A', 9) == 1;
+  if (!ok) {
+    fprintf(stderr, "❌ Rescan was not served from the cache\n");
+  }
+
+  // C evicts B (A was used more recently); B then evicts A
+  if (ok && !(frames_to_decode(decoder, 'C', 0) > 1 &&
+              frames_to_decode(decoder, 'B', 0) > 1 &&
+              frames_to_decode(decoder, 'C', 0) == 1 &&
+              frames_to_decode(decoder, 'A', 0) > 1)) {
+    fprintf(stderr, "❌ Cache did not evict the least recently used entry\n");
+    ok = false;
+  }
+
+  // The decoder does not own the cache: detach it before freeing
+  ur_decoder_set_cache(decoder, NULL);
+  ur_decoder_cache_free(cache);
+  cache = ur_decoder_cache_new(4, CACHE_MESSAGE_LEN - 1);
+  if (ok && cache) {
+    ur_decoder_set_cache(decoder, cache);
+  }
+  if (ok && !(cache && frames_to_decode(decoder, 'A', 0) > 1 &&
+              frames_to_decode(decoder, 'A', 0) > 1)) {
+    fprintf(stderr, "❌ Message over the byte cap was cached\n");
+    ok = false;
+  }
+
+  ur_decoder_free(decoder);
+  ur_decoder_cache_free(cache);
+  if (ok) {
+    printf("✅ PASS - rescans hit the cache, LRU eviction and byte cap\n");
+  }
+  return ok;
+}
+
 int main(int argc, char *argv[]) {
   if (ur_decoder_received_parts_count(NULL) != 0) {
     fprintf(stderr, "❌ NULL decoder should report 0 received parts\n");
@@ -174,6 +1013,28 @@ int main(int argc, char *argv[]) {
   if (!test_single_part_encoder()) {
     return 1;
   }
-  return run_test_suite(argc, argv, "UR Envelope API Test", TEST_CASES_DIR,
-                        ".UR_fragments.txt", test_file);
+  if (!test_next_part_into()) {
+    return 1;
+  }
+  if (!test_fragment_count_limit()) {
+    return 1;
+  }
+  if (!test_source_encoder()) {
+    return 1;
+  }
+  if (!test_decode_cache()) {
+    return 1;
+  }
+#if UR_FILE_SOURCE
+  if (!test_large_file_roundtrip()) {
+    return 1;
+  }
+  if (!test_file_sink_resize()) {
+    return 1;
+  }
+#endif
+  int status = run_test_suite(argc, argv, "UR Envelope API Test",
+                              TEST_CASES_DIR, ".UR_fragments.txt", test_file);
+  ur_decoder_free(reused_decoder);
+  return status;
 }
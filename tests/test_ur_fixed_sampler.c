@@ -0,0 +1,231 @@
+/*
+ * test_ur_fixed_sampler.c
+ *
+ * Checks the integer degree sampler (fountain_fixed.c) against the double
+ * reference in fountain_utils.c, which every UR implementation shares:
+ *  - Alias tables: for every seq_len up to MAX_SEQ_LEN (UR_MAX_SEQ_LEN's
+ *    default), fixed_sampler_init() yields the same thresholds, bit for
+ *    bit, and the same aliases as random_sampler_init() on the 1/(i+1)
+ *    degree weights.
+ *  - Draws: from a corpus of (seq_num, checksum) seeds, fixed_sampler_next()
+ *    and fixed_prng_next_int() return what random_sampler_next() and
+ *    prng_next_int() return and leave the PRNG in the same state.
+ *  - Rounding edges: PRNG outputs steered to conversion ties, to the top
+ *    of the range (which rounds to 1.0) and to zero.
+ */
+
+#include "../src/fountain_fixed.h"
+#include "../src/fountain_utils.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_SEQ_LEN 1024
+#define SEEDS_PER_SEQ_LEN 8
+#define DRAWS_PER_SEED 32
+
+static bool build_reference(random_sampler_t *sampler, size_t seq_len) {
+  double *probs = malloc(seq_len * sizeof(double));
+  if (!probs)
+    return false;
+  for (size_t i = 0; i < seq_len; i++) {
+    probs[i] = 1.0 / (i + 1);
+  }
+  bool ok = random_sampler_init(sampler, probs, seq_len);
+  free(probs);
+  return ok;
+}
+
+static bool same_table(const random_sampler_t *ref, const fixed_sampler_t *fx,
+                       size_t seq_len) {
+  if (fx->count != seq_len)
+    return false;
+  for (size_t i = 0; i < seq_len; i++) {
+    uint64_t bits;
+    memcpy(&bits, &ref->probs[i], sizeof(bits));
+    if (bits != fx->probs[i] || ref->aliases[i] != (int)fx->aliases[i]) {
+      fprintf(stderr, "❌ seq_len %zu entry %zu: %.17g/%d vs 0x%016llx/%d\n",
+              seq_len, i, ref->probs[i], ref->aliases[i],
+              (unsigned long long)fx->probs[i], (int)fx->aliases[i]);
+      return false;
+    }
+  }
+  return true;
+}
+
+// Seed the PRNG the way choose_fragments() does for a part
+static void seed_prng(prng_state_t *rng, uint32_t seq_num, uint32_t checksum) {
+  uint8_t seed[8] = {(uint8_t)(seq_num >> 24), (uint8_t)(seq_num >> 16),
+                     (uint8_t)(seq_num >> 8),  (uint8_t)seq_num,
+                     (uint8_t)(checksum >> 24), (uint8_t)(checksum >> 16),
+                     (uint8_t)(checksum >> 8), (uint8_t)checksum};
+  prng_init_from_bytes(rng, seed, sizeof(seed));
+}
+
+static bool same_draws(random_sampler_t *ref, const fixed_sampler_t *fx,
+                       prng_state_t *rng, size_t seq_len) {
+  for (int d = 0; d < DRAWS_PER_SEED; d++) {
+    prng_state_t a = *rng, b = *rng;
+    int ref_degree = random_sampler_next(ref, &a);
+    int fx_degree = fixed_sampler_next(fx, &b);
+    if (ref_degree != fx_degree || memcmp(&a, &b, sizeof(a)) != 0) {
+      fprintf(stderr, "❌ seq_len %zu: degree draw %d vs %d\n", seq_len,
+              ref_degree, fx_degree);
+      return false;
+    }
+
+    // A shuffle draw over the remaining fragments, then a few other ranges
+    uint32_t ranges[][2] = {{0, (uint32_t)(seq_len - 1)},
+                            {(uint32_t)seq_len, (uint32_t)seq_len * 3},
+                            {0, UINT32_MAX},
+                            {7, 7}};
+    for (size_t r = 0; r < sizeof(ranges) / sizeof(ranges[0]); r++) {
+      uint32_t ref_int = prng_next_int(&a, ranges[r][0], ranges[r][1]);
+      uint32_t fx_int = fixed_prng_next_int(&b, ranges[r][0], ranges[r][1]);
+      if (ref_int != fx_int || memcmp(&a, &b, sizeof(a)) != 0) {
+        fprintf(stderr, "❌ seq_len %zu: int draw in [%u, %u] %u vs %u\n",
+                seq_len, ranges[r][0], ranges[r][1], ref_int, fx_int);
+        return false;
+      }
+    }
+    *rng = a;
+  }
+  return true;
+}
+
+static bool test_all_seq_lens(void) {
+  for (size_t seq_len = 1; seq_len <= MAX_SEQ_LEN; seq_len++) {
+    random_sampler_t ref = {0};
+    fixed_sampler_t fx = {0};
+    bool ok = build_reference(&ref, seq_len) &&
+              fixed_sampler_init(&fx, seq_len) &&
+              same_table(&ref, &fx, seq_len);
+
+    for (uint32_t s = 0; ok && s < SEEDS_PER_SEQ_LEN; s++) {
+      prng_state_t rng;
+      seed_prng(&rng, (uint32_t)seq_len + 1 + s * 7919u,
+                0x9e3779b9u * (s + 1) ^ (uint32_t)seq_len);
+      ok = same_draws(&ref, &fx, &rng, seq_len);
+    }
+
+    random_sampler_free(&ref);
+    fixed_sampler_free(&fx);
+    if (!ok) {
+      fprintf(stderr, "❌ Fixed-point sampler diverges at seq_len %zu\n",
+              seq_len);
+      return false;
+    }
+  }
+  printf("✅ PASS - tables and draws match for seq_len 1..%d\n", MAX_SEQ_LEN);
+  return true;
+}
+
+// Multiplicative inverse of an odd number modulo 2^64 (Newton iteration)
+static uint64_t inverse_u64(uint64_t a) {
+  uint64_t x = a;
+  for (int i = 0; i < 6; i++) {
+    x *= 2 - a * x;
+  }
+  return x;
+}
+
+// State word whose PRNG output is v (output = rotl(state[1] * 5, 7) * 9)
+static uint64_t output_preimage(uint64_t v) {
+  uint64_t x = v * inverse_u64(9);
+  x = (x >> 7) | (x << 57);
+  return x * inverse_u64(5);
+}
+
+// Make the next two PRNG outputs first and second. A step sets
+// state[1] ^= state[2] ^ state[0], so state[2] picks the second output.
+static bool steer_prng(prng_state_t *rng, uint64_t first, uint64_t second) {
+  rng->state[1] = output_preimage(first);
+  rng->state[2] = output_preimage(second) ^ rng->state[1] ^ rng->state[0];
+
+  prng_state_t check = *rng;
+  return prng_next_uint64(&check) == first &&
+         prng_next_uint64(&check) == second;
+}
+
+static bool test_rounding_edges(void) {
+  // Conversion ties (the bits below a 53-bit mantissa exactly half) at
+  // 54, 60 and 64 bits with both mantissa parities, neighbours of a tie,
+  // the largest outputs (rounding to 1.0) and the smallest
+  const uint64_t values[] = {0,
+                             1,
+                             0x400,
+                             0x20000000000001ull,
+                             0x20000000000003ull,
+                             0x800000000000040ull,
+                             0x8000000000000c0ull,
+                             0x8000000000000400ull,
+                             0x8000000000000c00ull,
+                             0x80000000000003ffull,
+                             0x8000000000000401ull,
+                             0xfffffffffffffbffull,
+                             0xfffffffffffffc00ull,
+                             0xffffffffffffffffull};
+  const size_t seq_lens[] = {1, 2, 3, 10, 100, 641, 1000, MAX_SEQ_LEN};
+
+  for (size_t l = 0; l < sizeof(seq_lens) / sizeof(seq_lens[0]); l++) {
+    size_t seq_len = seq_lens[l];
+    random_sampler_t ref = {0};
+    fixed_sampler_t fx = {0};
+    bool ok =
+        build_reference(&ref, seq_len) && fixed_sampler_init(&fx, seq_len);
+
+    for (size_t i = 0; ok && i < sizeof(values) / sizeof(values[0]); i++) {
+      for (size_t j = 0; ok && j < sizeof(values) / sizeof(values[0]); j++) {
+        prng_state_t start;
+        seed_prng(&start, (uint32_t)i, (uint32_t)j);
+        if (!steer_prng(&start, values[i], values[j])) {
+          fprintf(stderr, "❌ Could not steer the PRNG\n");
+          ok = false;
+          break;
+        }
+
+        prng_state_t a = start, b = start;
+        int ref_degree = random_sampler_next(&ref, &a);
+        int fx_degree = fixed_sampler_next(&fx, &b);
+        if (ref_degree != fx_degree) {
+          fprintf(stderr, "❌ seq_len %zu: edge draw (%zu, %zu) %d vs %d\n",
+                  seq_len, i, j, ref_degree, fx_degree);
+          ok = false;
+        }
+
+        a = b = start;
+        uint32_t ref_int = prng_next_int(&a, (uint32_t)j, (uint32_t)seq_len);
+        uint32_t fx_int = fixed_prng_next_int(&b, (uint32_t)j,
+                                              (uint32_t)seq_len);
+        if (ref_int != fx_int) {
+          fprintf(stderr, "❌ seq_len %zu: edge int draw %zu %u vs %u\n",
+                  seq_len, i, ref_int, fx_int);
+          ok = false;
+        }
+      }
+    }
+
+    random_sampler_free(&ref);
+    fixed_sampler_free(&fx);
+    if (!ok)
+      return false;
+  }
+  printf("✅ PASS - rounding edge cases match\n");
+  return true;
+}
+
+int main(void) {
+  printf("=== UR Fixed-Point Sampler Test ===\n");
+  int passed = 0, total = 0;
+
+  total++;
+  if (test_all_seq_lens())
+    passed++;
+  total++;
+  if (test_rounding_edges())
+    passed++;
+
+  printf("\n=== Summary ===\n");
+  printf("Tests passed: %d/%d\n", passed, total);
+  return passed == total ? 0 : 1;
+}
@@ -5,7 +5,10 @@
  * bad CRC, truncated fragment, malformed CBOR. Every assertion
  * verifies that the API rejects cleanly and does not crash. Running
  * this under `make DEBUG=1 test` also checks memory safety on every
- * rejection path via ASan/UBSan.
+ * rejection path via ASan/UBSan. Also checks that a first part with an
+ * inconsistent fragment length is rejected, that a failing output sink
+ * ends the decode, and that the registry payload checks turn away
+ * mismatched payloads early and accept every fixture.
  */
 
 #include "../src/bytewords.h"
@@ -13,9 +16,12 @@
 #include "../src/fountain_encoder.h"
 #include "../src/fountain_types.h"
 #include "../src/types/bytes_type.h"
+#include "../src/types/payload_check.h"
 #include "../src/types/psbt.h"
 #include "../src/ur.h"
 #include "../src/ur_decoder.h"
+#include "../src/ur_encoder.h"
+#include "test_utils.h"
 #include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -82,6 +88,8 @@ static void test_null_and_empty(void) {
   uint8_t buf[1] = {0};
   ASSERT(bytes_from_cbor(buf, 0) == NULL,
          "bytes_from_cbor(buf, 0) returns NULL");
+  ASSERT(fountain_decoder_solved_bitmap(NULL, buf, sizeof(buf)) == 0,
+         "solved_bitmap(NULL, buf) returns 0");
 }
 
 static void test_malformed_ur(void) {
@@ -308,6 +316,243 @@ static void test_fountain_fragment_length_mismatch(void) {
          "length-mismatched fountain parts are all rejected (no OOB reduce)");
 }
 
+static void test_fountain_first_part_length(void) {
+  printf("\n=== fountain_first_part_length ===\n");
+  // 3 fragments of a 25-byte message are 9 bytes each; a first part that
+  // claims another length would place later fragments outside the message
+  const size_t lens[] = {8, 10, 25, 0};
+  for (size_t i = 0; i < sizeof(lens) / sizeof(lens[0]); i++) {
+    fountain_decoder_t *d = fountain_decoder_new();
+    fountain_encoder_part_t part = {0};
+    part.seq_num = 1;
+    part.seq_len = 3;
+    part.message_len = 25;
+    part.checksum = 0x11223344u;
+    part.data = calloc(lens[i] ? lens[i] : 1, 1);
+    part.data_len = lens[i];
+    ASSERT(!fountain_decoder_receive_part(d, &part) &&
+               fountain_decoder_expected_part_count(d) == 0,
+           "first part with an inconsistent length is rejected");
+    fountain_encoder_part_free(&part);
+    fountain_decoder_free(d);
+  }
+
+  fountain_decoder_t *d = fountain_decoder_new();
+  fountain_encoder_part_t part = {0};
+  part.seq_num = 1;
+  part.seq_len = 3;
+  part.message_len = 25;
+  part.checksum = 0x11223344u;
+  part.data = calloc(9, 1);
+  part.data_len = 9;
+  ASSERT(fountain_decoder_receive_part(d, &part) &&
+             fountain_decoder_expected_part_count(d) == 3,
+         "first part of ceil(message_len / seq_len) bytes is accepted");
+  fountain_encoder_part_free(&part);
+  fountain_decoder_free(d);
+}
+
+static bool failing_sink_write(void *ctx, size_t offset, const uint8_t *buf,
+                               size_t len) {
+  (void)ctx;
+  (void)offset;
+  (void)buf;
+  (void)len;
+  return false;
+}
+
+static bool failing_sink_read(void *ctx, size_t offset, uint8_t *buf,
+                              size_t len) {
+  (void)ctx;
+  (void)offset;
+  (void)buf;
+  (void)len;
+  return false;
+}
+
+static void test_sink_failure_terminal(void) {
+  printf("\n=== sink_failure_terminal ===\n");
+  fountain_decoder_t *d = fountain_decoder_new();
+  fountain_sink_t sink = {NULL, failing_sink_write, failing_sink_read, NULL,
+                          NULL};
+  ASSERT(fountain_decoder_set_sink(d, &sink), "sink accepted");
+
+  fountain_encoder_part_t part = {0};
+  part.seq_num = 1;
+  part.seq_len = 2;
+  part.message_len = 20;
+  part.checksum = 0x11223344u;
+  part.data = calloc(10, 1);
+  part.data_len = 10;
+  fountain_decoder_receive_part(d, &part);
+  fountain_encoder_part_free(&part);
+
+  ASSERT(fountain_decoder_is_complete(d) && !fountain_decoder_is_success(d),
+         "failed sink write ends the decode with an error");
+  fountain_decoder_free(d);
+}
+
+static void test_length_delimited(void) {
+  printf("\n=== length_delimited ===\n");
+  size_t len = strlen(VALID_FRAGMENT);
+
+  ur_decoder_t *d = ur_decoder_new();
+  ASSERT(ur_decoder_receive_part_len(d, NULL, 0) ==
+             UR_DECODER_ERROR_NULL_POINTER,
+         "receive_part_len rejects NULL buffer");
+  ASSERT(ur_decoder_receive_part_len(d, VALID_FRAGMENT, 0) ==
+             UR_DECODER_ERROR_INVALID_SCHEME,
+         "receive_part_len rejects zero length");
+  ASSERT(ur_decoder_receive_part_len(d, VALID_FRAGMENT, len - 4) ==
+             UR_DECODER_ERROR_INVALID_FRAGMENT,
+         "receive_part_len honours the length (truncated CRC)");
+
+  char *s = dup_fragment();
+  if (s) {
+    s[20] = '\0';
+    ASSERT(ur_decoder_receive_part_len(d, s, len) ==
+               UR_DECODER_ERROR_INVALID_SCHEME,
+           "receive_part_len rejects an embedded NUL");
+    free(s);
+  }
+
+  ASSERT(ur_decoder_receive_part_len(d, VALID_FRAGMENT, len) ==
+             UR_DECODER_PROCESSING,
+         "receive_part_len accepts the exact length");
+  ur_decoder_free(d);
+}
+
+// Encode cbor as crypto-psbt with 20-byte fragments and feed the parts to a
+// decoder with the registry payload check, skipping the first skip parts
+// (the pure fragments 0..skip-1). Returns the final state; *parts_fed
+// counts the parts it took.
+static ur_decoder_state_t decode_checked_psbt(const uint8_t *cbor,
+                                              size_t cbor_len, int skip,
+                                              int *parts_fed) {
+  ur_encoder_t *enc = ur_encoder_new("crypto-psbt", cbor, cbor_len, 20, 0, 20);
+  ur_decoder_t *d = ur_decoder_new();
+  ur_decoder_state_t state = UR_DECODER_ERROR_MEMORY;
+  *parts_fed = 0;
+  if (enc && d && ur_decoder_set_payload_check(d, registry_payload_check,
+                                               NULL)) {
+    state = UR_DECODER_PROCESSING;
+    for (int i = 0; i < 400 && !ur_decoder_state_is_terminal(state); i++) {
+      char *part = NULL;
+      if (!ur_encoder_next_part(enc, &part))
+        break;
+      if (i >= skip) {
+        state = ur_decoder_receive_part(d, part);
+        (*parts_fed)++;
+      }
+      free(part);
+    }
+  }
+  ur_decoder_free(d);
+  ur_encoder_free(enc);
+  return state;
+}
+
+static void test_payload_check(void) {
+  printf("\n=== payload_check ===\n");
+
+  // Predicates on leading bytes alone
+  const uint8_t psbt_head[] = {0x59, 0x01, 0x17, 'p', 's', 'b', 't', 0xff};
+  const uint8_t not_psbt[] = {0x59, 0x01, 0x17, 'p', 's', 'b', 'u', 0xff};
+  const uint8_t output_head[] = {0xd9, 0x01, 0x94, 0xd9, 0x01, 0x2f};
+  const uint8_t account_head[] = {0xa2, 0x01, 0x1a, 0x65, 0xfb};
+  const uint8_t small_map[] = {0xa1, 0x01, 0x1a, 0x65, 0xfb};
+  const uint8_t hdkey_head[] = {0xd9, 0x01, 0x2f, 0xa4};
+  ASSERT(psbt_payload_check(NULL, NULL, psbt_head, sizeof(psbt_head), 282),
+         "PSBT head with magic accepted");
+  ASSERT(!psbt_payload_check(NULL, NULL, not_psbt, sizeof(not_psbt), 282),
+         "byte string without the PSBT magic rejected");
+  ASSERT(!bytes_payload_check(NULL, NULL, psbt_head, sizeof(psbt_head), 300),
+         "byte string length disagreeing with message_len rejected");
+  ASSERT(psbt_payload_check(NULL, NULL, psbt_head, 2, 282),
+         "truncated head accepted (cannot judge)");
+  ASSERT(registry_payload_check(NULL, "crypto-output", output_head,
+                                sizeof(output_head), 123) &&
+             !registry_payload_check(NULL, "crypto-output", psbt_head,
+                                     sizeof(psbt_head), 282) &&
+             !registry_payload_check(NULL, "crypto-output", hdkey_head,
+                                     sizeof(hdkey_head), 100),
+         "output check wants a script expression or output tag");
+  ASSERT(registry_payload_check(NULL, "crypto-account", account_head,
+                                sizeof(account_head), 115) &&
+             !registry_payload_check(NULL, "crypto-account", small_map,
+                                     sizeof(small_map), 115) &&
+             !registry_payload_check(NULL, "crypto-account", output_head,
+                                     sizeof(output_head), 115),
+         "account check wants a map led by the fingerprint");
+  ASSERT(registry_payload_check(NULL, "x-unknown", not_psbt,
+                                sizeof(not_psbt), 282),
+         "payloads of unregistered types accepted");
+
+  // Every fixture passes the check for its type
+  const char *fixtures[] = {
+      "tests/test_cases/PSBTs/PSBT_1.UR_fragments.txt",
+      "tests/test_cases/PSBTs/PSBT_5.UR_fragments.txt",
+      "tests/test_cases/account/account_1.UR_fragments.txt",
+      "tests/test_cases/bytes/bytes_3.UR_fragments.txt",
+      "tests/test_cases/output/output_1.UR_fragments.txt",
+      "tests/test_cases/output/output_2.UR_fragments.txt"};
+  for (size_t f = 0; f < sizeof(fixtures) / sizeof(fixtures[0]); f++) {
+    int count = 0;
+    char **fragments = read_fragments_from_file(fixtures[f], &count);
+    ur_decoder_t *d = ur_decoder_new();
+    ur_decoder_state_t state = UR_DECODER_PROCESSING;
+    if (d && ur_decoder_set_payload_check(d, registry_payload_check, NULL)) {
+      for (int i = 0; i < count && !ur_decoder_state_is_terminal(state); i++)
+        state = ur_decoder_receive_part(d, fragments[i]);
+    }
+    ASSERT(fragments && state == UR_DECODER_OK, fixtures[f]);
+    ur_decoder_free(d);
+    free_fragments(fragments, count);
+  }
+
+  // A crypto-psbt whose byte string is not a PSBT stops at fragment 0,
+  // whether it arrives pure or is solved from mixed parts
+  uint8_t cbor[3 + 256];
+  cbor[0] = 0x59;
+  cbor[1] = 0x01;
+  cbor[2] = 0x00;
+  memset(cbor + 3, 0x42, 256);
+  int fed = 0;
+  ASSERT(decode_checked_psbt(cbor, sizeof(cbor), 0, &fed) ==
+                 UR_DECODER_ERROR_INVALID_PAYLOAD &&
+             fed == 1,
+         "mismatched payload rejected on its first frame");
+  ASSERT(decode_checked_psbt(cbor, sizeof(cbor), 1, &fed) ==
+             UR_DECODER_ERROR_INVALID_PAYLOAD,
+         "mismatched payload rejected once fragment 0 is solved");
+  memcpy(cbor + 3, "psbt\xff", 5);
+  ASSERT(decode_checked_psbt(cbor, sizeof(cbor), 1, &fed) == UR_DECODER_OK,
+         "PSBT-shaped payload decodes with the check on");
+
+  // Single-part: the whole payload is checked, and the state is terminal
+  char *bytewords = NULL;
+  char ur[128];
+  const uint8_t single[] = {0x44, 0xDE, 0xAD, 0xBE, 0xEF};
+  ASSERT(bytewords_encode(single, sizeof(single), &bytewords),
+         "bytewords_encode single-part payload");
+  snprintf(ur, sizeof(ur), "ur:crypto-psbt/%s", bytewords ? bytewords : "");
+  ur_decoder_t *d = ur_decoder_new();
+  ASSERT(ur_decoder_set_payload_check(d, registry_payload_check, NULL) &&
+             ur_decoder_receive_part(d, ur) ==
+                 UR_DECODER_ERROR_INVALID_PAYLOAD &&
+             ur_decoder_get_result(d) == NULL &&
+             ur_decoder_receive_part(d, VALID_FRAGMENT) ==
+                 UR_DECODER_ERROR_INVALID_PAYLOAD,
+         "single-part mismatch is terminal INVALID_PAYLOAD");
+  ASSERT(!ur_decoder_set_payload_check(d, NULL, NULL),
+         "payload check refused after the first part");
+  ur_decoder_reset(d, 0);
+  ASSERT(ur_decoder_receive_part(d, ur) == UR_DECODER_OK,
+         "reset clears the payload check");
+  ur_decoder_free(d);
+  free(bytewords);
+}
+
 int main(void) {
   printf("=== UR Negative-Path Tests ===\n");
   test_null_and_empty();
@@ -319,6 +564,10 @@ int main(void) {
   test_ok_terminal();
   test_malformed_cbor();
   test_fountain_fragment_length_mismatch();
+  test_fountain_first_part_length();
+  test_sink_failure_terminal();
+  test_length_delimited();
+  test_payload_check();
 
   printf("\n=== Summary ===\n");
   printf("Tests passed: %d/%d\n", asserts - failures, asserts);
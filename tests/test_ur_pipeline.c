@@ -0,0 +1,181 @@
+/*
+ * test_ur_pipeline.c
+ *
+ * Exercises the pipelined decoder (ur_pipeline_*) against the same streams
+ * as the single-threaded decoder:
+ *  - submit + wait per frame: decodes the same result as receive_part(),
+ *    with progress counters tracking the reducer.
+ *  - free-running submit with a ring large enough for the whole stream:
+ *    nothing is dropped and the decode completes after one wait.
+ *  - every frame submitted twice: the producer-side duplicate filter keeps
+ *    the ring and the result unaffected.
+ *  - a one-slot ring fed the same frame loop over and over: parts dropped
+ *    on a full ring are pushed again when the loop comes round, so the
+ *    decode still completes.
+ */
+
+#include "../src/ur_decoder.h"
+#include "../src/ur_pipeline.h"
+#include "test_harness.h"
+#include "test_utils.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define TEST_CASES_DIR "tests/test_cases/bytes"
+
+static bool same_result(const ur_result_t *a, const ur_result_t *b) {
+  return a && b && a->cbor_len == b->cbor_len && !strcmp(a->type, b->type) &&
+         !memcmp(a->cbor_data, b->cbor_data, a->cbor_len);
+}
+
+// Decode with the pipeline. wait_each waits for the reducer after every
+// submit; repeat submits each frame that many times in a row.
+static bool decode_pipelined(char **fragments, int fragment_count,
+                             size_t ring_capacity, bool wait_each, int repeat,
+                             const ur_result_t *expected) {
+  ur_pipeline_t *pipeline = ur_pipeline_new(ring_capacity);
+  if (!pipeline) {
+    fprintf(stderr, "❌ Failed to create pipeline\n");
+    return false;
+  }
+
+  bool ok = true;
+  size_t prev_received = 0;
+  for (int i = 0; i < fragment_count && ok; i++) {
+    ur_decoder_state_t state = UR_DECODER_PROCESSING;
+    for (int r = 0; r < repeat; r++) {
+      state = ur_pipeline_submit(pipeline, fragments[i], strlen(fragments[i]));
+    }
+    if (!wait_each) {
+      continue;
+    }
+
+    state = ur_pipeline_wait(pipeline);
+    size_t received = 0, parts = 0;
+    ur_pipeline_get_progress(pipeline, &received, &parts);
+    if (received < prev_received || received > parts) {
+      fprintf(stderr, "❌ Frame %d: progress %zu of %zu (was %zu)\n", i,
+              received, parts, prev_received);
+      ok = false;
+    }
+    prev_received = received;
+    if (ur_decoder_state_is_terminal(state))
+      break;
+  }
+
+  ur_decoder_state_t state = ur_pipeline_wait(pipeline);
+  if (ok && (state != UR_DECODER_OK ||
+             !same_result(ur_pipeline_get_result(pipeline), expected))) {
+    fprintf(stderr, "❌ Pipeline ended in state %d (%zu dropped)\n", state,
+            ur_pipeline_dropped_count(pipeline));
+    ok = false;
+  }
+  if (ok && ur_pipeline_dropped_count(pipeline) != 0) {
+    fprintf(stderr, "❌ Pipeline dropped %zu parts\n",
+            ur_pipeline_dropped_count(pipeline));
+    ok = false;
+  }
+
+  ur_pipeline_free(pipeline);
+  return ok;
+}
+
+// Replay the frames as a fixed animated loop into a one-slot ring, so
+// submits outrun the reducer and parts are dropped. A dropped frame must
+// not count as recently seen: its re-read on a later lap gets through.
+static bool decode_looped(char **fragments, int fragment_count,
+                          const ur_result_t *expected) {
+  ur_pipeline_t *pipeline = ur_pipeline_new(1);
+  if (!pipeline) {
+    fprintf(stderr, "❌ Failed to create pipeline\n");
+    return false;
+  }
+
+  ur_decoder_state_t state = UR_DECODER_PROCESSING;
+  for (int lap = 0; lap < 1000 && !ur_decoder_state_is_terminal(state);
+       lap++) {
+    for (int i = 0; i < fragment_count; i++) {
+      ur_pipeline_submit(pipeline, fragments[i], strlen(fragments[i]));
+    }
+    state = ur_pipeline_wait(pipeline);
+  }
+
+  bool ok = state == UR_DECODER_OK &&
+            same_result(ur_pipeline_get_result(pipeline), expected);
+  if (!ok) {
+    size_t received = 0, parts = 0;
+    ur_pipeline_get_progress(pipeline, &received, &parts);
+    fprintf(stderr, "❌ Looped decode ended in state %d: %zu of %zu, "
+                    "%zu dropped\n",
+            state, received, parts, ur_pipeline_dropped_count(pipeline));
+  } else {
+    printf("  %zu parts dropped on the full ring\n",
+           ur_pipeline_dropped_count(pipeline));
+  }
+
+  ur_pipeline_free(pipeline);
+  return ok;
+}
+
+static bool test_file(const char *filepath) {
+  printf("\n=== Testing file: %s ===\n", filepath);
+
+  int fragment_count = 0;
+  char **fragments = read_fragments_from_file(filepath, &fragment_count);
+  if (!fragments || fragment_count == 0) {
+    fprintf(stderr, "❌ No fragments found in file: %s\n", filepath);
+    return false;
+  }
+
+  // Reference decode on the calling thread
+  ur_decoder_t *decoder = ur_decoder_new();
+  ur_decoder_state_t state = UR_DECODER_PROCESSING;
+  for (int i = 0;
+       decoder && i < fragment_count && !ur_decoder_state_is_terminal(state);
+       i++) {
+    state = ur_decoder_receive_part(decoder, fragments[i]);
+  }
+  const ur_result_t *expected = ur_decoder_get_result(decoder);
+
+  bool ok = expected != NULL;
+  if (!ok) {
+    fprintf(stderr, "❌ Reference decode failed\n");
+  }
+  if (ok && decode_pipelined(fragments, fragment_count, 0, true, 1, expected)) {
+    printf("✅ PASS - submit + wait per frame\n");
+  } else {
+    ok = false;
+  }
+  if (ok && decode_pipelined(fragments, fragment_count, (size_t)fragment_count,
+                             false, 1, expected)) {
+    printf("✅ PASS - free-running submit\n");
+  } else {
+    ok = false;
+  }
+  if (ok && decode_pipelined(fragments, fragment_count, (size_t)fragment_count,
+                             false, 2, expected)) {
+    printf("✅ PASS - duplicate frames filtered\n");
+  } else {
+    ok = false;
+  }
+  if (ok && decode_looped(fragments, fragment_count, expected)) {
+    printf("✅ PASS - frames dropped on a full ring are retried\n");
+  } else {
+    ok = false;
+  }
+
+  ur_decoder_free(decoder);
+  free_fragments(fragments, fragment_count);
+  return ok;
+}
+
+int main(int argc, char *argv[]) {
+  if (ur_pipeline_get_state(NULL) != UR_DECODER_ERROR_NULL_POINTER ||
+      ur_pipeline_dropped_count(NULL) != 0) {
+    fprintf(stderr, "❌ NULL pipeline contract\n");
+    return 1;
+  }
+  return run_test_suite(argc, argv, "UR Pipeline Test", TEST_CASES_DIR,
+                        ".UR_fragments.txt", test_file);
+}
@@ -0,0 +1,190 @@
+/*
+ * test_ur_sha256.c
+ *
+ * Known-answer tests for the bundled SHA-256, run once per compression
+ * backend this build carries and the CPU supports (portable always, plus
+ * SHA-NI or ARMv8 unless built with UR_SHA256_ACCEL=0):
+ *  - FIPS 180-4 example messages: "", "abc", the 448- and 896-bit messages
+ *    and one million 'a'.
+ *  - Messages of 0-200 bytes around the padding edges (55/56/64 bytes and
+ *    the same one block further), digests from an independent
+ *    implementation.
+ *  - Every message hashed in one update() and split across calls of 1, 3,
+ *    63, 64 and 65 bytes.
+ *  - ur_bundled_sha256_8bytes() (the fountain seed path) on each backend.
+ *
+ * The source is included directly so the static backends can be selected
+ * one by one; the test does not link the library's SHA-256.
+ */
+
+#include "../src/sha256/sha256.c"
+#include <stdio.h>
+
+typedef struct {
+  const char *name;
+  sha256_blocks_fn fn;
+} backend_t;
+
+typedef struct {
+  const char *message; // NULL: the (i * 31 + 7) byte pattern
+  size_t len;
+  const char *digest;
+} kat_t;
+
+static const kat_t KATS[] = {
+    {"", 0,
+     "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855"},
+    {"abc", 3,
+     "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad"},
+    {"abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq", 56,
+     "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1"},
+    {"abcdefghbcdefghicdefghijdefghijkefghijklfghijklmghijklmnhijklmno"
+     "ijklmnopjklmnopqklmnopqrlmnopqrsmnopqrstnopqrstu",
+     112, "cf5b16a778af8380036ce59e7b0492370b249b11e8f07a51afac45037afee9d1"},
+    {NULL, 1,
+     "ca358758f6d27e6cf45272937977a748fd88391db679ceda7dc7bf1f005ee879"},
+    {NULL, 8,
+     "4fb900ca3f5832fcc475b79bf07217bf0edfe9d39ea10f5cf624246ff68b47de"},
+    {NULL, 55,
+     "8aa994584139d128848eeebc4e815639ba5ab6e6e39574195a63ac4f14f7c43b"},
+    {NULL, 56,
+     "ad574708f75c044c9b85de64cb568ee7711ff4f36448c6242f053ba8f6cc2b63"},
+    {NULL, 57,
+     "5b46e502092be01b1100193e089fdda95638c12e19a1d24f308eb2c3d3ae849d"},
+    {NULL, 63,
+     "280ed3e8ff1df845b2e7dfe6ac6cee817bef20e783cc65abc41b818b4d2fe076"},
+    {NULL, 64,
+     "c6ab9724ade5b6a7a1edfffb12f3aa9181351355af8fd08c919952ad211339dd"},
+    {NULL, 65,
+     "788367c73c7ddf4c53f65e68cc0d943e6227ab55b0e78ba63ace822b1c6301c0"},
+    {NULL, 111,
+     "dd1413178fb627f9abbc041ffe39c44aa7aaa0e2e6d2ca5c4528ac7073a2da45"},
+    {NULL, 112,
+     "a65c92dac124062d0ab951a42773cb04fc98d1d4bf8897b176f8cff3509d379e"},
+    {NULL, 119,
+     "3d610547d68216dedf7435a4fb6260353911f6b3fd3f18805ddb8be285d726fe"},
+    {NULL, 120,
+     "1f80156a804cb7862ad113e8200e9d74499723e7c7854d5f48776d3148e09656"},
+    {NULL, 127,
+     "192409cd280e14b743642ad1343fbd3e82d9305de72c078117745a679210cc3d"},
+    {NULL, 128,
+     "cc548ca2dec1f6fe4f58b2e27aa9c7521607df1130d140b55a4dad0665302356"},
+    {NULL, 129,
+     "81e89a7b2911aaa7795f9e3d4910cb47d6cd2b00d83b8399481527261a1a7519"},
+    {NULL, 200,
+     "44cae5223d431caed4a9e32271d6abf17c3f2f4abac45fcdb48a99fcc6072a09"},
+};
+
+static const char MILLION_A_DIGEST[] =
+    "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0";
+
+// Update chunk sizes; 0 hashes the message in a single call
+static const size_t SPLITS[] = {0, 1, 3, 63, 64, 65};
+
+static void to_hex(const BYTE hash[SHA256_BLOCK_SIZE], char *hex) {
+  for (size_t i = 0; i < SHA256_BLOCK_SIZE; i++) {
+    snprintf(hex + 2 * i, 3, "%02x", hash[i]);
+  }
+}
+
+static void fill_message(const kat_t *kat, BYTE *buf) {
+  for (size_t i = 0; i < kat->len; i++) {
+    buf[i] = kat->message ? (BYTE)kat->message[i] : (BYTE)(i * 31 + 7);
+  }
+}
+
+static bool check_digest(const char *backend, const char *what, size_t len,
+                         const BYTE hash[SHA256_BLOCK_SIZE],
+                         const char *expected) {
+  char hex[2 * SHA256_BLOCK_SIZE + 1];
+  to_hex(hash, hex);
+  if (strcmp(hex, expected) != 0) {
+    fprintf(stderr, "❌ %s: %s of %zu bytes gave %s\n", backend, what, len,
+            hex);
+    return false;
+  }
+  return true;
+}
+
+static bool test_backend(const backend_t *backend) {
+  printf("\n=== Testing %s backend ===\n", backend->name);
+  ur_bundled_sha256_blocks_impl = backend->fn;
+
+  bool ok = true;
+  BYTE buf[200];
+  BYTE hash[SHA256_BLOCK_SIZE];
+  for (size_t k = 0; k < sizeof(KATS) / sizeof(KATS[0]); k++) {
+    const kat_t *kat = &KATS[k];
+    fill_message(kat, buf);
+    for (size_t s = 0; s < sizeof(SPLITS) / sizeof(SPLITS[0]); s++) {
+      size_t chunk = SPLITS[s] ? SPLITS[s] : kat->len;
+      CRYAL_SHA256_CTX ctx;
+      ur_bundled_sha256_init(&ctx);
+      for (size_t off = 0; off < kat->len; off += chunk) {
+        size_t n = kat->len - off < chunk ? kat->len - off : chunk;
+        ur_bundled_sha256_update(&ctx, buf + off, n);
+      }
+      ur_bundled_sha256_final(&ctx, hash);
+      char what[32];
+      snprintf(what, sizeof(what), "update(%zu)", SPLITS[s]);
+      ok = check_digest(backend->name, what, kat->len, hash, kat->digest) &&
+           ok;
+    }
+    if (kat->len == 8) {
+      ur_bundled_sha256_8bytes(buf, hash);
+      ok = check_digest(backend->name, "8bytes", 8, hash, kat->digest) && ok;
+    }
+  }
+
+  BYTE block[1000];
+  memset(block, 'a', sizeof(block));
+  CRYAL_SHA256_CTX ctx;
+  ur_bundled_sha256_init(&ctx);
+  for (int i = 0; i < 1000; i++) {
+    ur_bundled_sha256_update(&ctx, block, sizeof(block));
+  }
+  ur_bundled_sha256_final(&ctx, hash);
+  ok = check_digest(backend->name, "million 'a'", 1000000, hash,
+                    MILLION_A_DIGEST) &&
+       ok;
+
+  if (ok) {
+    printf("✅ PASS - %s backend matches every known answer\n",
+           backend->name);
+  }
+  return ok;
+}
+
+int main(void) {
+  printf("=== UR SHA-256 Known-Answer Test ===\n");
+
+  backend_t backends[3];
+  size_t count = 0;
+  backends[count++] =
+      (backend_t){"portable", ur_bundled_sha256_blocks_portable};
+#if defined(UR_SHA256_X86_SHANI)
+  if (ur_bundled_sha256_cpu_has_shani()) {
+    backends[count++] = (backend_t){"SHA-NI", ur_bundled_sha256_blocks_shani};
+  } else {
+    printf("SHA-NI compiled in but not supported by this CPU; skipped\n");
+  }
+#endif
+#if defined(UR_SHA256_ARMV8)
+  if (ur_bundled_sha256_cpu_has_armv8()) {
+    backends[count++] = (backend_t){"ARMv8", ur_bundled_sha256_blocks_armv8};
+  } else {
+    printf("ARMv8 SHA2 compiled in but not supported by this CPU; skipped\n");
+  }
+#endif
+
+  int passed = 0, total = 0;
+  for (size_t i = 0; i < count; i++) {
+    total++;
+    if (test_backend(&backends[i]))
+      passed++;
+  }
+
+  printf("\n=== Summary ===\n");
+  printf("Tests passed: %d/%d\n", passed, total);
+  return passed == total ? 0 : 1;
+}
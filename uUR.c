@@ -5,10 +5,12 @@
 #include "src/types/bip39.h"
 #include "src/types/bytes_type.h"
 #include "src/types/output.h"
+#include "src/types/payload_check.h"
 #include "src/types/psbt.h"
 #include "src/ur.h"
 #include "src/ur_decoder.h"
 #include "src/ur_encoder.h"
+#include "src/utils.h"
 
 // ---------------------------------------------------------------------------
 // MicroPython version compatibility.
@@ -48,6 +50,7 @@
 typedef struct {
   mp_obj_base_t base;
   ur_decoder_t *decoder;
+  mp_obj_t result_cbor; // bytes taken by take_result(), MP_OBJ_NULL before
 } mp_obj_ur_decoder_t;
 
 // UREncoder class structure
@@ -76,19 +79,12 @@ static void ur_print(const mp_print_t *print, mp_obj_t self_in,
   }
 }
 
-static mp_obj_t ur_make_new(const mp_obj_type_t *type, size_t n_args,
-                            size_t n_kw, const mp_obj_t *args) {
-  mp_arg_check_num(n_args, n_kw, 2, 2, false);
-
-  // Extract type and CBOR data from args
-  const char *ur_type = mp_obj_str_get_str(args[0]);
-
-  mp_buffer_info_t cbor_buf;
-  mp_get_buffer_raise(args[1], &cbor_buf, MP_BUFFER_READ);
-
+// Wrap a copy of the given type and CBOR in a new UR object
+static mp_obj_t ur_obj_new(const mp_obj_type_t *type, const char *ur_type,
+                           const uint8_t *cbor, size_t cbor_len) {
   // Create internal UR object first so a failure doesn't leak the wrapper
   // through the exception long-jump in mp_raise_msg.
-  ur_t *ur = ur_new(ur_type, cbor_buf.buf, cbor_buf.len);
+  ur_t *ur = ur_new(ur_type, cbor, cbor_len);
   if (!ur) {
     mp_raise_msg(&mp_type_MemoryError,
                  MP_ERROR_TEXT("Failed to create UR object"));
@@ -101,6 +97,19 @@ static mp_obj_t ur_make_new(const mp_obj_type_t *type, size_t n_args,
   return MP_OBJ_FROM_PTR(self);
 }
 
+static mp_obj_t ur_make_new(const mp_obj_type_t *type, size_t n_args,
+                            size_t n_kw, const mp_obj_t *args) {
+  mp_arg_check_num(n_args, n_kw, 2, 2, false);
+
+  // Extract type and CBOR data from args
+  const char *ur_type = mp_obj_str_get_str(args[0]);
+
+  mp_buffer_info_t cbor_buf;
+  mp_get_buffer_raise(args[1], &cbor_buf, MP_BUFFER_READ);
+
+  return ur_obj_new(type, ur_type, cbor_buf.buf, cbor_buf.len);
+}
+
 static mp_obj_t ur_del(mp_obj_t self_in) {
   mp_obj_ur_t *self = MP_OBJ_TO_PTR(self_in);
   if (self->ur) {
@@ -179,6 +188,7 @@ static mp_obj_t ur_decoder_make_new(const mp_obj_type_t *type, size_t n_args,
   mp_obj_ur_decoder_t *self =
       mp_obj_malloc_with_finaliser(mp_obj_ur_decoder_t, type);
   self->decoder = decoder;
+  self->result_cbor = MP_OBJ_NULL;
 
   return MP_OBJ_FROM_PTR(self);
 }
@@ -193,25 +203,127 @@ static mp_obj_t ur_decoder_del(mp_obj_t self_in) {
 }
 static MP_DEFINE_CONST_FUN_OBJ_1(ur_decoder_del_obj, ur_decoder_del);
 
-// receive_part method — returns the decoder state (one of the module's
-// DECODER_* constants) after processing, mirroring the C API. Decode
-// errors are returned, not raised: junk or misread frames are expected in
-// a QR scan loop. NOTE: DECODER_OK == 0 is falsy in Python — compare the
-// return against the DECODER_* constants, never use it as a boolean.
-static mp_obj_t ur_decoder_receive_part_py(mp_obj_t self_in,
-                                           mp_obj_t part_str) {
+// receive_part(part, length=None) method — returns the decoder state (one of
+// the module's DECODER_* constants) after processing, mirroring the C API.
+// part may be a str or any buffer-protocol object (bytes, bytearray,
+// memoryview), so camera QR decoders can pass their output without first
+// building a str; length limits the read to a prefix of a reused buffer.
+// Decode errors are returned, not raised: junk or misread frames are
+// expected in a QR scan loop. NOTE: DECODER_OK == 0 is falsy in Python —
+// compare the return against the DECODER_* constants, never use it as a
+// boolean.
+static mp_obj_t ur_decoder_feed(size_t n_args, const mp_obj_t *args,
+                                bool enqueue) {
+  mp_obj_ur_decoder_t *self = MP_OBJ_TO_PTR(args[0]);
+
+  if (!self->decoder) {
+    mp_raise_msg(&mp_type_RuntimeError, MP_ERROR_TEXT("URDecoder is closed"));
+  }
+
+  mp_buffer_info_t part;
+  mp_get_buffer_raise(args[1], &part, MP_BUFFER_READ);
+
+  size_t part_len = part.len;
+  if (n_args > 2 && args[2] != mp_const_none) {
+    mp_int_t length = mp_obj_get_int(args[2]);
+    if (length < 0 || (size_t)length > part.len) {
+      mp_raise_ValueError(MP_ERROR_TEXT("length out of range"));
+    }
+    part_len = (size_t)length;
+  }
+
+  const char *buf = (const char *)part.buf;
+  ur_decoder_state_t state =
+      enqueue ? ur_decoder_enqueue_part_len(self->decoder, buf, part_len)
+              : ur_decoder_receive_part_len(self->decoder, buf, part_len);
+  return mp_obj_new_int((mp_int_t)state);
+}
+
+static mp_obj_t ur_decoder_receive_part_py(size_t n_args,
+                                           const mp_obj_t *args) {
+  return ur_decoder_feed(n_args, args, false);
+}
+static MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(ur_decoder_receive_part_obj, 2, 3,
+                                           ur_decoder_receive_part_py);
+
+// enqueue_part(part, length=None) method — same arguments and return as
+// receive_part, but only parses and queues the frame; step() runs the
+// fountain reduction work. For UI loops that must bound time per frame.
+static mp_obj_t ur_decoder_enqueue_part_py(size_t n_args,
+                                           const mp_obj_t *args) {
+  return ur_decoder_feed(n_args, args, true);
+}
+static MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(ur_decoder_enqueue_part_obj, 2, 3,
+                                           ur_decoder_enqueue_part_py);
+
+// step(budget=0) method — runs whole queued parts until budget bytes of
+// XOR/copy work are done (at least one part; one part's cascade may exceed
+// the budget) and returns True while work remains. Check the state
+// attribute afterwards for completion.
+static mp_obj_t ur_decoder_step_py(size_t n_args, const mp_obj_t *args) {
+  mp_obj_ur_decoder_t *self = MP_OBJ_TO_PTR(args[0]);
+
+  if (!self->decoder) {
+    mp_raise_msg(&mp_type_RuntimeError, MP_ERROR_TEXT("URDecoder is closed"));
+  }
+
+  mp_int_t budget = n_args > 1 ? mp_obj_get_int(args[1]) : 0;
+  if (budget < 0) {
+    mp_raise_ValueError(MP_ERROR_TEXT("budget must be >= 0"));
+  }
+  return mp_obj_new_bool(ur_decoder_step(self->decoder, (size_t)budget));
+}
+static MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(ur_decoder_step_obj, 1, 2,
+                                           ur_decoder_step_py);
+
+// receive_parts(frames) method — feeds a list or tuple of frames (each a str
+// or buffer, as for receive_part) in one native call and returns
+// (state, accepted, duplicate, rejected). A frame is a duplicate when it
+// decodes without error but the processed-parts count does not move, i.e.
+// the fountain layer had already seen it. Stops at the first terminal state;
+// frames after it are not counted.
+static mp_obj_t ur_decoder_receive_parts_py(mp_obj_t self_in,
+                                            mp_obj_t frames_in) {
   mp_obj_ur_decoder_t *self = MP_OBJ_TO_PTR(self_in);
 
   if (!self->decoder) {
     mp_raise_msg(&mp_type_RuntimeError, MP_ERROR_TEXT("URDecoder is closed"));
   }
 
-  const char *part_cstr = mp_obj_str_get_str(part_str);
-  return mp_obj_new_int(
-      (mp_int_t)ur_decoder_receive_part(self->decoder, part_cstr));
+  size_t n_frames;
+  mp_obj_t *frames;
+  mp_obj_get_array(frames_in, &n_frames, &frames);
+
+  ur_decoder_state_t state = ur_decoder_get_state(self->decoder);
+  mp_int_t accepted = 0, duplicate = 0, rejected = 0;
+  for (size_t i = 0; i < n_frames && !ur_decoder_state_is_terminal(state);
+       i++) {
+    mp_buffer_info_t part;
+    mp_get_buffer_raise(frames[i], &part, MP_BUFFER_READ);
+
+    size_t before = ur_decoder_processed_parts_count(self->decoder);
+    state = ur_decoder_receive_part_len(self->decoder, (const char *)part.buf,
+                                        part.len);
+    if (ur_decoder_state_is_error(state)) {
+      rejected++;
+    } else if (state == UR_DECODER_PROCESSING &&
+               ur_decoder_processed_parts_count(self->decoder) == before) {
+      duplicate++;
+    } else {
+      accepted++;
+    }
+  }
+
+  mp_obj_t summary[4] = {
+      mp_obj_new_int((mp_int_t)state),
+      mp_obj_new_int(accepted),
+      mp_obj_new_int(duplicate),
+      mp_obj_new_int(rejected),
+  };
+  return mp_obj_new_tuple(4, summary);
 }
-static MP_DEFINE_CONST_FUN_OBJ_2(ur_decoder_receive_part_obj,
-                                 ur_decoder_receive_part_py);
+static MP_DEFINE_CONST_FUN_OBJ_2(ur_decoder_receive_parts_obj,
+                                 ur_decoder_receive_parts_py);
 
 // estimated_percent_complete(weight_mixed_frames=False) method.
 // weight_mixed_frames is an opt-in flag: the default (False) returns the
@@ -241,13 +353,143 @@ static mp_obj_t ur_decoder_estimated_percent_complete_py(
 static MP_DEFINE_CONST_FUN_OBJ_KW(ur_decoder_estimated_percent_complete_obj, 1,
                                   ur_decoder_estimated_percent_complete_py);
 
+// Move the decoded CBOR out of the C heap into one GC bytes object, cached on
+// the wrapper so every later accessor shares it. The bytes object is built
+// before ownership is taken: if the allocation raises, the C buffer is still
+// owned by the decoder and nothing leaks. Returns MP_OBJ_NULL without a
+// result.
+static mp_obj_t ur_decoder_result_cbor(mp_obj_ur_decoder_t *self) {
+  if (self->result_cbor != MP_OBJ_NULL) {
+    return self->result_cbor;
+  }
+  ur_result_t *result = ur_decoder_get_result(self->decoder);
+  if (!result || !result->cbor_data) {
+    return MP_OBJ_NULL;
+  }
+
+  mp_obj_t cbor = mp_obj_new_bytes(result->cbor_data, result->cbor_len);
+  size_t cbor_len = 0;
+  uint8_t *owned = ur_decoder_take_result_cbor(self->decoder, &cbor_len);
+  safe_free(owned);
+  self->result_cbor = cbor;
+  return cbor;
+}
+
+// take_result() method — returns the decoded CBOR as bytes (None before the
+// decode succeeds) and releases the decoder's C copy, so a large PSBT is held
+// once instead of once in C and again per `result` access. Repeated calls
+// return the same object.
+static mp_obj_t ur_decoder_take_result_py(mp_obj_t self_in) {
+  mp_obj_ur_decoder_t *self = MP_OBJ_TO_PTR(self_in);
+  mp_obj_t cbor = ur_decoder_result_cbor(self);
+  return cbor == MP_OBJ_NULL ? mp_const_none : cbor;
+}
+static MP_DEFINE_CONST_FUN_OBJ_1(ur_decoder_take_result_obj,
+                                 ur_decoder_take_result_py);
+
+// psbt() method — returns a memoryview of the PSBT bytes inside the
+// crypto-psbt CBOR without copying them (None before the decode succeeds).
+// The view slices the bytes object from take_result(), so it stays valid
+// after the decoder is dropped.
+static mp_obj_t ur_decoder_psbt_py(mp_obj_t self_in) {
+  mp_obj_ur_decoder_t *self = MP_OBJ_TO_PTR(self_in);
+  ur_result_t *result = ur_decoder_get_result(self->decoder);
+  if (!result) {
+    return mp_const_none;
+  }
+  if (strcmp(result->type, PSBT_TYPE.name) != 0) {
+    mp_raise_ValueError(MP_ERROR_TEXT("result is not a crypto-psbt"));
+  }
+
+  mp_obj_t cbor = ur_decoder_result_cbor(self);
+  if (cbor == MP_OBJ_NULL) {
+    return mp_const_none;
+  }
+  mp_buffer_info_t bufinfo;
+  mp_get_buffer_raise(cbor, &bufinfo, MP_BUFFER_READ);
+
+  size_t psbt_len = 0;
+  const uint8_t *psbt =
+      psbt_payload_from_cbor((const uint8_t *)bufinfo.buf, bufinfo.len,
+                             &psbt_len);
+  if (!psbt) {
+    mp_raise_ValueError(MP_ERROR_TEXT("Invalid PSBT CBOR data"));
+  }
+
+#if MICROPY_PY_BUILTINS_MEMORYVIEW
+  // Slice through the memoryview subscript so the view keeps the bytes
+  // object's head pointer (the GC ignores interior pointers).
+  mp_int_t start = (mp_int_t)(psbt - (const uint8_t *)bufinfo.buf);
+  mp_obj_t view =
+      mp_call_function_1(MP_OBJ_FROM_PTR(&mp_type_memoryview), cbor);
+  mp_obj_t slice =
+      mp_obj_new_slice(MP_OBJ_NEW_SMALL_INT(start),
+                       MP_OBJ_NEW_SMALL_INT(start + (mp_int_t)psbt_len),
+                       mp_const_none);
+  return mp_obj_subscr(view, slice, MP_OBJ_SENTINEL);
+#else
+  // Ports built without memoryview get a copy of just the payload.
+  return mp_obj_new_bytes(psbt, psbt_len);
+#endif
+}
+static MP_DEFINE_CONST_FUN_OBJ_1(ur_decoder_psbt_obj, ur_decoder_psbt_py);
+
+// reset(shrink_threshold=0) method — clears the decoder for the next scan
+// but keeps its C tables and buffers, so back-to-back scans skip the
+// allocator. A retained structure above shrink_threshold bytes is freed
+// (0 keeps everything). A bytes object from take_result() stays valid.
+static mp_obj_t ur_decoder_reset_py(size_t n_args, const mp_obj_t *args) {
+  mp_obj_ur_decoder_t *self = MP_OBJ_TO_PTR(args[0]);
+
+  if (!self->decoder) {
+    mp_raise_msg(&mp_type_RuntimeError, MP_ERROR_TEXT("URDecoder is closed"));
+  }
+
+  mp_int_t shrink_threshold = n_args > 1 ? mp_obj_get_int(args[1]) : 0;
+  if (shrink_threshold < 0) {
+    mp_raise_ValueError(MP_ERROR_TEXT("shrink_threshold must be >= 0"));
+  }
+  ur_decoder_reset(self->decoder, (size_t)shrink_threshold);
+  self->result_cbor = MP_OBJ_NULL;
+  return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(ur_decoder_reset_obj, 1, 2,
+                                           ur_decoder_reset_py);
+
+// check_payload() method — before the first part, makes the decoder check
+// the leading payload bytes against the registry type (crypto-psbt,
+// crypto-output, ...) and stop with DECODER_ERR_INVALID_PAYLOAD on a
+// mismatch, instead of decoding the whole animation first. Returns False
+// once parts have been received.
+static mp_obj_t ur_decoder_check_payload_py(mp_obj_t self_in) {
+  mp_obj_ur_decoder_t *self = MP_OBJ_TO_PTR(self_in);
+
+  if (!self->decoder) {
+    mp_raise_msg(&mp_type_RuntimeError, MP_ERROR_TEXT("URDecoder is closed"));
+  }
+  return mp_obj_new_bool(ur_decoder_set_payload_check(
+      self->decoder, registry_payload_check, NULL));
+}
+static MP_DEFINE_CONST_FUN_OBJ_1(ur_decoder_check_payload_obj,
+                                 ur_decoder_check_payload_py);
+
 // URDecoder locals dict
 static const mp_rom_map_elem_t ur_decoder_locals_dict_table[] = {
     {MP_ROM_QSTR(MP_QSTR___del__), MP_ROM_PTR(&ur_decoder_del_obj)},
     {MP_ROM_QSTR(MP_QSTR_receive_part),
      MP_ROM_PTR(&ur_decoder_receive_part_obj)},
+    {MP_ROM_QSTR(MP_QSTR_receive_parts),
+     MP_ROM_PTR(&ur_decoder_receive_parts_obj)},
+    {MP_ROM_QSTR(MP_QSTR_enqueue_part),
+     MP_ROM_PTR(&ur_decoder_enqueue_part_obj)},
+    {MP_ROM_QSTR(MP_QSTR_step), MP_ROM_PTR(&ur_decoder_step_obj)},
     {MP_ROM_QSTR(MP_QSTR_estimated_percent_complete),
      MP_ROM_PTR(&ur_decoder_estimated_percent_complete_obj)},
+    {MP_ROM_QSTR(MP_QSTR_take_result), MP_ROM_PTR(&ur_decoder_take_result_obj)},
+    {MP_ROM_QSTR(MP_QSTR_psbt), MP_ROM_PTR(&ur_decoder_psbt_obj)},
+    {MP_ROM_QSTR(MP_QSTR_reset), MP_ROM_PTR(&ur_decoder_reset_obj)},
+    {MP_ROM_QSTR(MP_QSTR_check_payload),
+     MP_ROM_PTR(&ur_decoder_check_payload_obj)},
 };
 static MP_DEFINE_CONST_DICT(ur_decoder_locals_dict,
                             ur_decoder_locals_dict_table);
@@ -270,13 +512,18 @@ static void ur_decoder_attr(mp_obj_t self_in, qstr attr, mp_obj_t *dest) {
         return;
       }
 
-      // Create UR object
-      mp_obj_t type_str = mp_obj_new_str(result->type, strlen(result->type));
-      mp_obj_t cbor_bytes =
-          mp_obj_new_bytearray(result->cbor_len, result->cbor_data);
-
-      mp_obj_t args[2] = {type_str, cbor_bytes};
-      dest[0] = ur_make_new(&mp_type_ur, 2, 0, args);
+      // The UR copies the CBOR straight from the decoder or, once
+      // take_result() has moved it out of the C heap, from the cached bytes,
+      // so either way its cbor attribute is the same bytearray copy.
+      const uint8_t *cbor = result->cbor_data;
+      size_t cbor_len = result->cbor_len;
+      if (self->result_cbor != MP_OBJ_NULL) {
+        mp_buffer_info_t cbor_buf;
+        mp_get_buffer_raise(self->result_cbor, &cbor_buf, MP_BUFFER_READ);
+        cbor = cbor_buf.buf;
+        cbor_len = cbor_buf.len;
+      }
+      dest[0] = ur_obj_new(&mp_type_ur, result->type, cbor, cbor_len);
     } else if (attr == MP_QSTR_state) {
       // Closed decoder -> NULL -> DECODER_ERR_NULL_POINTER, matching the C
       // API's get_state(NULL) behavior.
@@ -294,6 +541,38 @@ static void ur_decoder_attr(mp_obj_t self_in, qstr attr, mp_obj_t *dest) {
         dest[0] =
             mp_obj_new_int(ur_decoder_processed_parts_count(self->decoder));
       }
+    } else if (attr == MP_QSTR_received_parts_count) {
+      // NULL-safe in C: a closed decoder reports 0
+      dest[0] = mp_obj_new_int(ur_decoder_received_parts_count(self->decoder));
+    } else if (attr == MP_QSTR_solved_bitmap) {
+      // bytes; bit (i % 8) of byte (i // 8) is set once fragment i is
+      // solved. The default UR_MAX_SEQ_LEN fits the stack buffer, so the
+      // bytes object is the only allocation.
+      uint8_t stack_bits[128];
+      size_t len = ur_decoder_solved_bitmap(self->decoder, NULL, 0);
+      uint8_t *bits = stack_bits;
+      if (len > sizeof(stack_bits)) {
+        bits = m_new(uint8_t, len);
+      }
+      ur_decoder_solved_bitmap(self->decoder, bits, len);
+      dest[0] = mp_obj_new_bytes(bits, len);
+      if (bits != stack_bits) {
+        m_del(uint8_t, bits, len);
+      }
+    } else if (attr == MP_QSTR_stats) {
+      // (expected_part_count, received_parts_count, processed_parts_count,
+      //  mixed_parts_count, message_len, fragment_len)
+      ur_decoder_stats_t stats;
+      ur_decoder_get_stats(self->decoder, &stats);
+      mp_obj_t items[6] = {
+          mp_obj_new_int((mp_int_t)stats.expected_part_count),
+          mp_obj_new_int((mp_int_t)stats.received_parts_count),
+          mp_obj_new_int((mp_int_t)stats.processed_parts_count),
+          mp_obj_new_int((mp_int_t)stats.mixed_parts_count),
+          mp_obj_new_int((mp_int_t)stats.message_len),
+          mp_obj_new_int((mp_int_t)stats.fragment_len),
+      };
+      dest[0] = mp_obj_new_tuple(6, items);
     } else {
       // Method lookup from locals_dict. Use the method-load protocol
       // (dest[0]=method, dest[1]=self) instead of allocating a bound
@@ -452,6 +731,45 @@ static mp_obj_t ur_encoder_next_part_py(mp_obj_t self_in) {
 static MP_DEFINE_CONST_FUN_OBJ_1(ur_encoder_next_part_obj,
                                  ur_encoder_next_part_py);
 
+// next_part_into(buf) method — renders the next part into a writable buffer
+// (e.g. a bytearray sized once from part_buffer_len()) and returns its
+// length, so an animated QR loop allocates no GC object per frame (the C
+// encoder still mallocs briefly while mixing a multi-part frame). The part is
+// NUL-terminated in buf; only buf[:length] is the frame. Raises ValueError
+// if buf is too small, without consuming a part.
+static mp_obj_t ur_encoder_next_part_into_py(mp_obj_t self_in,
+                                             mp_obj_t buf_in) {
+  mp_obj_ur_encoder_t *self = MP_OBJ_TO_PTR(self_in);
+
+  if (!self->encoder) {
+    mp_raise_msg(&mp_type_RuntimeError, MP_ERROR_TEXT("UREncoder is closed"));
+  }
+
+  mp_buffer_info_t buf;
+  mp_get_buffer_raise(buf_in, &buf, MP_BUFFER_WRITE);
+  if (buf.len < ur_encoder_part_buffer_len(self->encoder)) {
+    mp_raise_ValueError(MP_ERROR_TEXT("buffer too small"));
+  }
+
+  size_t part_len = 0;
+  if (!ur_encoder_next_part_into(self->encoder, (char *)buf.buf, buf.len,
+                                 &part_len)) {
+    mp_raise_msg(&mp_type_RuntimeError,
+                 MP_ERROR_TEXT("Failed to generate next part"));
+  }
+  return mp_obj_new_int((mp_int_t)part_len);
+}
+static MP_DEFINE_CONST_FUN_OBJ_2(ur_encoder_next_part_into_obj,
+                                 ur_encoder_next_part_into_py);
+
+// part_buffer_len() method — buffer size next_part_into() needs
+static mp_obj_t ur_encoder_part_buffer_len_py(mp_obj_t self_in) {
+  mp_obj_ur_encoder_t *self = MP_OBJ_TO_PTR(self_in);
+  return mp_obj_new_int((mp_int_t)ur_encoder_part_buffer_len(self->encoder));
+}
+static MP_DEFINE_CONST_FUN_OBJ_1(ur_encoder_part_buffer_len_obj,
+                                 ur_encoder_part_buffer_len_py);
+
 // is_complete method
 static mp_obj_t ur_encoder_is_complete_py(mp_obj_t self_in) {
   mp_obj_ur_encoder_t *self = MP_OBJ_TO_PTR(self_in);
@@ -478,6 +796,10 @@ static MP_DEFINE_CONST_FUN_OBJ_1(ur_encoder_is_single_part_obj,
 static const mp_rom_map_elem_t ur_encoder_locals_dict_table[] = {
     {MP_ROM_QSTR(MP_QSTR___del__), MP_ROM_PTR(&ur_encoder_del_obj)},
     {MP_ROM_QSTR(MP_QSTR_next_part), MP_ROM_PTR(&ur_encoder_next_part_obj)},
+    {MP_ROM_QSTR(MP_QSTR_next_part_into),
+     MP_ROM_PTR(&ur_encoder_next_part_into_obj)},
+    {MP_ROM_QSTR(MP_QSTR_part_buffer_len),
+     MP_ROM_PTR(&ur_encoder_part_buffer_len_obj)},
     {MP_ROM_QSTR(MP_QSTR_is_complete), MP_ROM_PTR(&ur_encoder_is_complete_obj)},
     {MP_ROM_QSTR(MP_QSTR_is_single_part),
      MP_ROM_PTR(&ur_encoder_is_single_part_obj)},
@@ -913,6 +1235,8 @@ static const mp_rom_map_elem_t bc_ur_globals_table[] = {
      MP_ROM_INT(UR_DECODER_ERROR_MEMORY)},
     {MP_ROM_QSTR(MP_QSTR_DECODER_ERR_NULL_POINTER),
      MP_ROM_INT(UR_DECODER_ERROR_NULL_POINTER)},
+    {MP_ROM_QSTR(MP_QSTR_DECODER_ERR_INVALID_PAYLOAD),
+     MP_ROM_INT(UR_DECODER_ERROR_INVALID_PAYLOAD)},
 };
 static MP_DEFINE_CONST_DICT(bc_ur_globals, bc_ur_globals_table);
 